@@ -1,8 +1,23 @@
-uniform vec3 Color;
+#version 430 core
+in vec2 FSInputLocalPosition;
+in float FSInputRadius;
+in float FSInputStripeRadius;
+in vec3 FSInputColor;
 
 out vec4 FSOutColor;
 
 void main()
 {
-    FSOutColor = vec4(Color, 1.0);
+    // distanta pana la centru; fwidth da cat se schimba pe un pixel, deci marginea are mereu un pixel latime
+    float distance = length(FSInputLocalPosition);
+    float pixelWidth = max(fwidth(distance), 1e-4);
+
+    float coverage = clamp(0.5 - (distance - FSInputRadius) / pixelWidth, 0.0, 1.0);
+    if (coverage <= 0.0)
+        discard;
+
+    float stripe = FSInputStripeRadius > 0.0 ? clamp(0.5 - (distance - FSInputStripeRadius) / pixelWidth, 0.0, 1.0) : 0.0;
+    vec3 color = mix(FSInputColor, vec3(1.0, 1.0, 1.0), stripe);
+
+    FSOutColor = vec4(color, coverage);
 }
\ No newline at end of file
@@ -1,12 +1,26 @@
 #version 430 core
 layout (location = 0) in vec3 VSInputPosition;
+layout (location = 1) in vec2 VSInputInstancePosition;
+layout (location = 2) in float VSInputInstanceRadius;
+layout (location = 3) in vec3 VSInputInstanceColor;
+layout (location = 4) in float VSInputInstanceStripeRadius;
 
 uniform mat4 Projection;
-uniform mat4 Model;
+uniform float PixelSize;
 
+out vec2 FSInputLocalPosition;
+out float FSInputRadius;
+out float FSInputStripeRadius;
 out vec3 FSInputColor;
 
 void main()
 {
-    gl_Position = Projection * Model * vec4(VSInputPosition, 1.0);
+    // patratul este putin mai mare decat cercul, ca marginea netezita sa nu fie taiata
+    vec2 localPosition = VSInputPosition.xy * (VSInputInstanceRadius + 2.0 * PixelSize);
+    gl_Position = Projection * vec4(localPosition + VSInputInstancePosition, 0.0, 1.0);
+
+    FSInputLocalPosition = localPosition;
+    FSInputRadius = VSInputInstanceRadius;
+    FSInputStripeRadius = VSInputInstanceStripeRadius;
+    FSInputColor = VSInputInstanceColor;
 }
\ No newline at end of file
@@ -2,8 +2,12 @@
 
 #include "Game.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <iostream>
-#include <utility>
+#include <random>
+#include <string>
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "Constants.h"
@@ -11,71 +15,71 @@
 using namespace std;
 using namespace glm;
 
-Game::PlayerDetails::PlayerDetails() :
-    Score(0),
-    Dead(false),
-    AllowedBalls(vector<Ball*>()),
-    FinishedBalls(false)
-{
-}
-
 Game::Game(float windowWidth, float windowHeight) :
+    m_holeInstanceCount(0),
+    m_ballInstanceCount(0),
+    m_table(random_device()()),
+    m_replayLog(m_table.GetSeed()),
     m_windowWidth(windowWidth),
     m_windowHeight(windowHeight),
     m_mousePressed(false),
-    m_whiteBall(nullptr),
     m_mousePosition(vec2(0.0f, 0.0f)),
-    m_gameState(Game::GameState::Playing),
-    m_currentPlayer(Game::Players::Player1)
+    m_pixelSize(1.0f),
+    m_physicsAccumulator(0.0f),
+    m_printStatistics(false)
 {
-    m_playerDetails[(int)Players::Player1] = PlayerDetails();
-    m_playerDetails[(int)Players::Player2] = PlayerDetails();
-    cout << "Este randul jucatorului " << (m_currentPlayer + 1) << "." << endl;
+    // fizica merge in modul determinist, ca meciul inregistrat sa poata fi refacut exact din lovituri
+    m_table.GetPhysics().SetDeterministic(true);
 
     m_tableShader = new Shader("Table.vert", "Table.frag");
-    m_colorShader = new Shader("Ball.vert", "Ball.frag");
+    m_ballShader = new Shader("Ball.vert", "Ball.frag");
+    m_lineShader = new Shader("Line.vert", "Line.frag");
+
+    m_tableProjection = m_tableShader->GetUniform<mat4>("Projection");
+    m_tableModel = m_tableShader->GetUniform<mat4>("Model");
+    m_ballProjection = m_ballShader->GetUniform<mat4>("Projection");
+    m_ballPixelSize = m_ballShader->GetUniform<float>("PixelSize");
+    m_lineProjection = m_lineShader->GetUniform<mat4>("Projection");
+    m_lineColor = m_lineShader->GetUniform<vec3>("Color");
+
+    m_streamBuffer = new StreamBuffer(STREAM_BUFFER_FRAME_SIZE);
 
     CreateTableBuffers();
     CreateBallBuffers();
     CreateLineBuffers();
 
     OnResize(windowWidth, windowHeight);
-
-    CreateBalls();
-    CreateHoles();
 }
 
 Game::~Game()
 {
-    for (auto& hole : m_holes)
-    {
-        if (hole)
-        {
-            delete hole;
-            hole = nullptr;
-        }
-    }
-    m_holes.clear();
-
-    for (auto& ball : m_balls)
-    {
-        if (ball)
-        {
-            delete ball;
-            ball = nullptr;
-        }
-    }
-    m_balls.clear();
-
     FreeLineBuffers();
     FreeBallBuffers();
     FreeTableBuffers();
 
+    if (m_streamBuffer)
+    {
+        delete m_streamBuffer;
+        m_streamBuffer = nullptr;
+    }
+
     if (m_tableShader)
     {
         delete m_tableShader;
         m_tableShader = nullptr;
     }
+
+    if (m_ballShader)
+    {
+        delete m_ballShader;
+        m_ballShader = nullptr;
+    }
+
+    if (m_lineShader)
+    {
+        delete m_lineShader;
+        m_lineShader = nullptr;
+    }
 }
 
 void Game::OnResize(float windowWidth, float windowHeight)
@@ -96,6 +100,9 @@ void Game::OnResize(float windowWidth, float windowHeight)
     else
         newHeight = Constants::GAME_WIDTH / screenAspectRatio;
     
+    // cate unitati din joc acopera un pixel din fereastra
+    m_pixelSize = newWidth / windowWidth;
+
     m_projectionMatrix = scale(mat4(1.0), vec3(2.0f / newWidth, 2.0f / newHeight, 1.0f));
     m_projectionMatrix = m_projectionMatrix * translate(mat4(1.0f), -vec3((float)newWidth / 2.0f, (float)newHeight / 2.0f, 0.0f));
     m_projectionMatrix = m_projectionMatrix * translate(mat4(1.0f), vec3((newWidth - Constants::GAME_WIDTH) * 0.5f, (newHeight - Constants::GAME_HEIGHT) * 0.5f, 0.0f));
@@ -153,185 +160,153 @@ void Game::ProcessInput(GLFWwindow* window)
 
 void Game::Update(float deltaTime)
 {
-    if (m_gameState == GameState::Finished)
-        return;
-
-    for (auto& ball : m_balls)
-        ball->Update(deltaTime, m_balls, m_holes);
+    if (IsAiTurn())
+        PlayAiTurn();
 
-    int badIndex = -1;
-    do
-    {
-        badIndex = -1;
+    // Fizica merge mereu cu pasul fix Physics::DETERMINISTIC_STEP, indiferent de cat a durat cadrul. Este singurul ceas:
+    // fiecare FixedUpdate face exact un pas in Physics, asa ca interpolarea si regulile merg cu pasii facuti.
+    // Daca un cadru a fost prea lung, se fac cel mult MAX_PHYSICS_STEPS_PER_FRAME pasi, iar restul timpului se pierde.
+    m_physicsAccumulator += deltaTime;
 
-        for (int i = 0; i < m_balls.size(); i++)
-        {
-            if (!m_balls[i]->OnBoard())
-            {
-                badIndex = i;
-                bool badBall = true;
-                for (auto& allowedBall : m_playerDetails[m_currentPlayer].AllowedBalls)
-                {
-                    if (m_balls[i] == allowedBall)
-                    {
-                        badBall = false;
-                        cout << "Jucatorul " << (m_currentPlayer + 1) << " a bagat in gaura bila." << endl;
-                    }
-                }
-                if (badBall && m_balls[i]->GetBallType() != Ball::BallType::Black)
-                {
-                    cout << "Jucatorul " << (m_currentPlayer + 1) << " a bagat in gaura bila care apartine celuilalt jucator." << endl;
-                }
-            }
-        }
-
-        if (badIndex != -1)
-        {
-            if (m_balls[badIndex])
-            {
-                delete m_balls[badIndex];
-                m_balls[badIndex] = nullptr;
-            }
-            m_balls[badIndex] = m_balls[m_balls.size() - 1];
-            m_balls.pop_back();
-        }
-
-    } while (badIndex != -1);
-
-    if (!m_playerDetails[m_currentPlayer].FinishedBalls)
+    int steps = 0;
+    while (m_physicsAccumulator >= Physics::DETERMINISTIC_STEP && steps < MAX_PHYSICS_STEPS_PER_FRAME)
     {
-        bool finishedBalls = true;
-        for (auto& allowedBall : m_playerDetails[m_currentPlayer].AllowedBalls)
-        {
-            for (auto& ball : m_balls)
-            {
-                if (allowedBall == ball)
-                    finishedBalls = false;
-            }
-        }
-        m_playerDetails[m_currentPlayer].FinishedBalls = finishedBalls;
-        if (finishedBalls)
-        {
-            cout << "Jucatorul " << (m_currentPlayer + 1) << " si-a terminat bilele." << endl;
-        }
+        FixedUpdate(Physics::DETERMINISTIC_STEP);
+        m_physicsAccumulator -= Physics::DETERMINISTIC_STEP;
+        steps++;
     }
 
-    bool foundBlack = false;
-    for (auto& ball : m_balls)
-    {
-        if (ball->GetBallType() == Ball::BallType::Black)
-        {
-            foundBlack = true;
-            break;
-        }
-    }
+    if (m_physicsAccumulator >= Physics::DETERMINISTIC_STEP)
+        m_physicsAccumulator = fmod(m_physicsAccumulator, Physics::DETERMINISTIC_STEP);
+}
 
-    if (!foundBlack)
-    {
-        if (m_playerDetails[m_currentPlayer].FinishedBalls)
-            m_playerDetails[(int)(m_currentPlayer + 1) % 2].Dead = true;
-        else
-            m_playerDetails[m_currentPlayer].Dead = true;
-        
-        cout << "Jucatorul 1 a " << (m_playerDetails[Players::Player1].Dead ? "pierdut" : "castigat") << "." << endl;
-        cout << "Jucatorul 2 a " << (m_playerDetails[Players::Player2].Dead ? "pierdut" : "castigat") << "." << endl;
+// Meciul este scris in fisier doar la cerere; loviturile date pana atunci sunt scrise si ele.
+bool Game::StartRecording(const string& filename)
+{
+    return m_replayLog.StartRecording(filename);
+}
 
-        m_gameState = GameState::Finished;
-        return;
-    }
+void Game::SetPrintStatistics(bool printStatistics)
+{
+    m_printStatistics = printStatistics;
+}
+
+void Game::FixedUpdate(float deltaTime)
+{
+    bool waiting = m_table.GetGameState() == Table::GameState::Waiting;
 
-    switch (m_gameState)
+    m_table.GetWorld().StorePreviousPositions();
+    m_table.Update(deltaTime);
+
+    // cat a costat lovitura care tocmai s-a terminat
+    if (m_printStatistics && waiting && m_table.GetGameState() != Table::GameState::Waiting)
     {
-    case GameState::Waiting:
-        {
-            bool allStopped = true;
-            for (auto& ball : m_balls)
-            {
-                if (!ball->IsStopped())
-                {
-                    allStopped = false;
-                    break;
-                }
-            }
-            if (allStopped)
-            {
-                m_gameState = GameState::Playing;
-                m_currentPlayer = (Players)(((int)m_currentPlayer + 1) % 2);
-                cout << "Este randul jucatorului " << (m_currentPlayer + 1) << "." << endl;
-            }
-        }
-        break;
-    case GameState::Playing:
-        break;
+        const Physics::StepStatistics& statistics = m_table.GetPhysics().GetStepStatistics();
+        cout << "Lovitura: " << statistics.Steps << " pasi, " << statistics.Substeps << " subpasi (cel mult " << statistics.MaxSubsteps << " intr-un pas)." << endl;
     }
 }
 
 void Game::Render()
 {
+    // pozitia desenata este interpolata intre ultimele doua stari ale fizicii
+    float alpha = m_physicsAccumulator / Physics::DETERMINISTIC_STEP;
+
+    // predictia este facuta inainte de BeginFrame, ca marimea liniilor ajutatoare sa fie cunoscuta
+    bool showHelperLines = m_mousePressed && m_table.GetGameState() == Table::GameState::Playing && !IsAiTurn();
+    int helperLineVerticesCount = 0;
+    if (showHelperLines)
+    {
+        vec2 whiteBallPosition = m_table.GetWorld().GetBall(m_table.GetWhiteBall()).GetPosition();
+        m_trajectoryPredictor.Predict(m_table, whiteBallPosition - m_mousePosition);
+        helperLineVerticesCount = AIM_LINE_VERTICES_COUNT + m_trajectoryPredictor.GetPointCount();
+    }
+
+    int instanceCount = (int)m_table.GetHoles().size() + m_table.GetWorld().GetCount();
+    m_streamBuffer->BeginFrame(sizeof(BallInstance) * instanceCount + sizeof(vec2) * helperLineVerticesCount + 64);
+
     mat4 tableModel = scale(mat4(1.0f), vec3(Constants::GAME_WIDTH * 0.5f, Constants::GAME_HEIGHT * 0.5f, 1.0f));
     tableModel = translate(mat4(1.0f), vec3(Constants::GAME_WIDTH / 2.0f, Constants::GAME_HEIGHT / 2.0f, 0.0f)) * tableModel;
     
     m_tableShader->Use();
-    m_tableShader->SetMatrix4("Projection", m_projectionMatrix);
-    m_tableShader->SetMatrix4("Model", tableModel);
+    m_tableShader->Set(m_tableProjection, m_projectionMatrix);
+    m_tableShader->Set(m_tableModel, tableModel);
 
     glBindVertexArray(m_tableVao);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_tableEbo);
     glDrawElements(GL_TRIANGLES, TABLE_INDICES_COUNT, GL_UNSIGNED_INT, 0);
 
-    for (auto& hole : m_holes)
-    {
-        mat4 holeModel = scale(mat4(1.0f), vec3(HOLE_RADIUS, HOLE_RADIUS, 1.0f));
-        holeModel = translate(mat4(1.0f), vec3(hole->GetPosition().x, hole->GetPosition().y, 0.0f)) * holeModel;
+    UploadBallInstances(alpha);
 
-        m_colorShader->Use();
-        m_colorShader->SetVec3("Color", vec3(0.0f, 0.0f, 0.0f));
-        m_colorShader->SetMatrix4("Projection", m_projectionMatrix);
-        m_colorShader->SetMatrix4("Model", holeModel);
+    // gaurile intr-o desenare, iar bilele impreuna cu dungile lor in a doua;
+    // marginile cercurilor sunt netezite in shader prin transparenta
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-        glBindVertexArray(m_ballVao);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, BALL_OUTSIDE_VERTICES_COUNT + 2);
-    }
+    m_ballShader->Use();
+    m_ballShader->Set(m_ballProjection, m_projectionMatrix);
+    m_ballShader->Set(m_ballPixelSize, m_pixelSize);
 
-    if (m_mousePressed && m_gameState == GameState::Playing)
+    glBindVertexArray(m_ballVao);
+    glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, BALL_QUAD_VERTICES_COUNT, m_holeInstanceCount, 0);
+
+    if (showHelperLines)
         RenderHelperLines();
 
-    for (auto& ball : m_balls)
-    {
-        mat4 ballModel = scale(mat4(1.0f), vec3(Ball::BALL_RADIUS, Ball::BALL_RADIUS, 1.0f));
-        ballModel = translate(mat4(1.0f), vec3(ball->GetPosition().x, ball->GetPosition().y, 0.0f)) * ballModel;
+    m_ballShader->Use();
 
-        m_colorShader->Use();
-        m_colorShader->SetVec3("Color", ball->GetColor());
-        m_colorShader->SetMatrix4("Projection", m_projectionMatrix);
-        m_colorShader->SetMatrix4("Model", ballModel);
+    glBindVertexArray(m_ballVao);
+    glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, BALL_QUAD_VERTICES_COUNT, m_ballInstanceCount, m_holeInstanceCount);
 
-        glBindVertexArray(m_ballVao);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, BALL_OUTSIDE_VERTICES_COUNT + 2);
+    glDisable(GL_BLEND);
 
-        if (!ball->IsSolid())
-        {
-            ballModel = scale(mat4(1.0f), vec3(Ball::BALL_RADIUS * 0.5f, Ball::BALL_RADIUS * 0.5f, 1.0f));
-            ballModel = translate(mat4(1.0f), vec3(ball->GetPosition().x, ball->GetPosition().y, 0.0f)) * ballModel;
+    m_streamBuffer->EndFrame();
+}
 
-            m_colorShader->Use();
-            m_colorShader->SetVec3("Color", vec3(1.0f, 1.0f, 1.0f));
-            m_colorShader->SetMatrix4("Projection", m_projectionMatrix);
-            m_colorShader->SetMatrix4("Model", ballModel);
+void Game::OnMouseReleased()
+{
+    if (IsAiTurn())
+        return;
 
-            glBindVertexArray(m_ballVao);
-            glDrawArrays(GL_TRIANGLE_FAN, 0, BALL_OUTSIDE_VERTICES_COUNT + 2);
-        }
-    }
+    vec2 whiteBallPosition = m_table.GetWorld().GetBall(m_table.GetWhiteBall()).GetPosition();
+    Shoot(whiteBallPosition - m_mousePosition);
 }
 
-void Game::OnMouseReleased()
+void Game::Shoot(vec2 velocity)
+{
+    if (m_table.ApplyShot(velocity))
+        m_replayLog.AddShot(velocity);
+}
+
+bool Game::IsAiTurn() const
 {
-    if (m_gameState == GameState::Playing)
+    return m_table.GetGameState() == Table::GameState::Playing && m_table.GetCurrentPlayer() == AI_PLAYER;
+}
+
+// Planificarea ruleaza pe un thread separat, cu simularile pe pool-ul AiPlayer-ului, si pe o copie a mesei, pentru ca
+// Update continua sa miste fizica mesei intre timp. Jocul ramane responsiv, iar lovitura este data in primul cadru dupa
+// ce planul este gata.
+void Game::PlayAiTurn()
+{
+    if (!m_aiPlan.valid())
     {
-        m_whiteBall->SetVelocity(m_whiteBall->GetPosition() - m_mousePosition);
-        m_gameState = GameState::Waiting;
+        m_aiPlan = async(launch::async, [this, table = m_table]()
+        {
+            return m_aiPlayer.PlanShot(table);
+        });
+        return;
     }
+
+    if (m_aiPlan.wait_for(chrono::seconds(0)) != future_status::ready)
+        return;
+
+    AiPlayer::ShotPlan plan = m_aiPlan.get();
+    if (m_printStatistics)
+    {
+        cout << "Calculatorul a incercat " << plan.Candidates << " lovituri (" << plan.EvaluatedShots << " simulari) in "
+             << (int)(plan.Seconds * 1000.0f) << " ms." << endl;
+    }
+
+    Shoot(plan.Velocity);
 }
 
 void Game::CreateTableBuffers()
@@ -392,20 +367,14 @@ void Game::FreeTableBuffers()
 
 void Game::CreateBallBuffers()
 {
-    constexpr int totalVerticesCount = BALL_OUTSIDE_VERTICES_COUNT + 2;
-    vec3 vertices[totalVerticesCount];
-
-    int index = 0;
-    vertices[index++] = vec3(0.0f, 0.0f, 0.0f);
-    constexpr float angleIncrement = two_pi<float>() / (float)BALL_OUTSIDE_VERTICES_COUNT;
-    float angle = 0.0f;
-
-    while(index < totalVerticesCount - 1)
+    // un patrat [-1, 1] x [-1, 1]; cercul este decupat in Ball.frag
+    vec3 vertices[BALL_QUAD_VERTICES_COUNT] =
     {
-        vertices[index++] = vec3(cosf(angle), sinf(angle), 0.0f);
-        angle += angleIncrement;
-    }
-    vertices[index++] = vertices[1];
+        vec3(-1.0f, -1.0f, 0.0f),
+        vec3( 1.0f, -1.0f, 0.0f),
+        vec3(-1.0f,  1.0f, 0.0f),
+        vec3( 1.0f,  1.0f, 0.0f)
+    };
 
     glGenVertexArrays(1, &m_ballVao);
 
@@ -414,10 +383,30 @@ void Game::CreateBallBuffers()
     glGenBuffers(1, &m_ballVbo);
 
     glBindBuffer(GL_ARRAY_BUFFER, m_ballVbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vec3) * totalVerticesCount, vertices, GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vec3) * BALL_QUAD_VERTICES_COUNT, vertices, GL_STATIC_DRAW);
 
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(vec3), (void*)0);
     glEnableVertexAttribArray(0);
+
+    // atributele 1-4 sunt pe instanta: pozitie, raza, culoare si raza dungii (0 pentru bilele pline).
+    // Vin din m_streamBuffer, legat pe BALL_INSTANCE_BINDING in fiecare cadru.
+    glVertexAttribFormat(1, 2, GL_FLOAT, GL_FALSE, offsetof(BallInstance, Position));
+    glVertexAttribBinding(1, BALL_INSTANCE_BINDING);
+    glEnableVertexAttribArray(1);
+
+    glVertexAttribFormat(2, 1, GL_FLOAT, GL_FALSE, offsetof(BallInstance, Radius));
+    glVertexAttribBinding(2, BALL_INSTANCE_BINDING);
+    glEnableVertexAttribArray(2);
+
+    glVertexAttribFormat(3, 3, GL_FLOAT, GL_FALSE, offsetof(BallInstance, Color));
+    glVertexAttribBinding(3, BALL_INSTANCE_BINDING);
+    glEnableVertexAttribArray(3);
+
+    glVertexAttribFormat(4, 1, GL_FLOAT, GL_FALSE, offsetof(BallInstance, StripeRadius));
+    glVertexAttribBinding(4, BALL_INSTANCE_BINDING);
+    glEnableVertexAttribArray(4);
+
+    glVertexBindingDivisor(BALL_INSTANCE_BINDING, 1);
 }
 
 void Game::FreeBallBuffers()
@@ -425,6 +414,10 @@ void Game::FreeBallBuffers()
     glBindVertexArray(m_ballVao);
 
     glDisableVertexAttribArray(0);
+    glDisableVertexAttribArray(1);
+    glDisableVertexAttribArray(2);
+    glDisableVertexAttribArray(3);
+    glDisableVertexAttribArray(4);
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glDeleteBuffers(1, &m_ballVbo);
@@ -433,26 +426,15 @@ void Game::FreeBallBuffers()
     glDeleteVertexArrays(1, &m_ballVao);
 }
 
+// Liniile nu au buffer propriu: capetele lor sunt scrise direct in m_streamBuffer in fiecare cadru.
 void Game::CreateLineBuffers()
 {
-    vec3 vertices[] =
-    {
-        vec3(0.0f, 0.0f, 0.0f),
-        vec3(0.0f, 1.0f, 0.0f)
-    };
-
-    int verticesCount = sizeof(vertices) / sizeof(vec3);
-
     glGenVertexArrays(1, &m_lineVao);
 
     glBindVertexArray(m_lineVao);
 
-    glGenBuffers(1, &m_lineVbo);
-
-    glBindBuffer(GL_ARRAY_BUFFER, m_lineVbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vec3) * verticesCount, vertices, GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(vec3), (void*)0);
+    glVertexAttribFormat(0, 2, GL_FLOAT, GL_FALSE, 0);
+    glVertexAttribBinding(0, 0);
     glEnableVertexAttribArray(0);
 }
 
@@ -462,323 +444,87 @@ void Game::FreeLineBuffers()
 
     glDisableVertexAttribArray(0);
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glDeleteBuffers(1, &m_lineVbo);
-
     glBindVertexArray(0);
     glDeleteVertexArrays(1, &m_lineVao);
 }
 
-void Game::CreateBalls()
+void Game::UploadBallInstances(float alpha)
 {
-    m_whiteBall = new Ball(vec2(0.0f, 0.0f), vec3(0.0f, 0.0f, 0.0f), true, Ball::BallType::White);
-    m_balls.push_back(m_whiteBall);
-
-    m_balls.push_back(new Ball(vec2(0.0f, 0.0f), vec3(0.0f, 0.0f, 0.0f), true, Ball::BallType::Black));
-
-    m_balls.push_back(new Ball(vec2(0.0f, 0.0f), vec3(1.0f, 0.956f, 0.156f), true));
-    m_balls.push_back(new Ball(vec2(0.0f, 0.0f), vec3(0.215f, 0.333f, 0.921f), true));
-    m_balls.push_back(new Ball(vec2(0.0f, 0.0f), vec3(0.776f, 0.145f, 0.756f), true));
-    m_balls.push_back(new Ball(vec2(0.0f, 0.0f), vec3(1.0f, 0.439f, 0.062f), true));
-    m_balls.push_back(new Ball(vec2(0.0f, 0.0f), vec3(0.976f, 0.050f, 0.058f), true));
-    m_balls.push_back(new Ball(vec2(0.0f, 0.0f), vec3(0.050f, 0.811f, 0.603f), true));
-    m_balls.push_back(new Ball(vec2(0.0f, 0.0f), vec3(0.713f, 0.121f, 0.156f), true));
-
-    m_balls.push_back(new Ball(vec2(0.0f, 0.0f), vec3(0.0f, 0.654f, 0.384f), false));
-    m_balls.push_back(new Ball(vec2(0.0f, 0.0f), vec3(0.843f, 0.274f, 0.050f), false));
-    m_balls.push_back(new Ball(vec2(0.0f, 0.0f), vec3(0.807f, 0.117f, 0.780f), false)); 
-    m_balls.push_back(new Ball(vec2(0.0f, 0.0f), vec3(0.156f, 0.239f, 0.729f), false));
-    m_balls.push_back(new Ball(vec2(0.0f, 0.0f), vec3(0.992f, 0.823f, 0.168f), false));
-    m_balls.push_back(new Ball(vec2(0.0f, 0.0f), vec3(0.560f, 0.090f, 0.125f), false));
-    m_balls.push_back(new Ball(vec2(0.0f, 0.0f), vec3(0.933f, 0.070f, 0.078f), false));
-
-    for (int i = 1; i < m_balls.size(); i++)
-    {
-        int otherIndex = (rand() % (m_balls.size() - 1)) + 1;
-        swap(m_balls[i], m_balls[otherIndex]);
-    }
+    const BallWorld& world = m_table.GetWorld();
+    const vector<Hole*>& holes = m_table.GetHoles();
 
-    for (auto& ball : m_balls)
-    {
-        if (ball->GetBallType() == Ball::BallType::Normal)
-        {
-            if (ball->IsSolid())
-                m_playerDetails[Players::Player1].AllowedBalls.push_back(ball);
-            else
-                m_playerDetails[Players::Player2].AllowedBalls.push_back(ball);
-        }
-    }
-
-    int columnCount = 0;
-    int totalPerColumn = 1;
+    m_holeInstanceCount = (int)holes.size();
+    m_ballInstanceCount = world.GetCount();
 
-    float xPosition = (Constants::GAME_WIDTH / 2.0f) + NORMAL_BALLS_OFFSET;
+    int instanceCount = m_holeInstanceCount + m_ballInstanceCount;
 
-    for (int i = 1; i < m_balls.size(); i++)
+    BallInstance* instances = (BallInstance*)m_streamBuffer->Map(sizeof(BallInstance) * instanceCount);
+    if (!instances)
     {
-        float y = Constants::GAME_HEIGHT / 2.0f;
-        float totalDist = NORMAL_BALLS_DIST_BETWEEN * (totalPerColumn - 1);
-        y = y - (totalDist / 2.0f);
-        if (totalPerColumn >= 2)
-        {
-            y = y + (totalDist) * (float(columnCount) / float(totalPerColumn - 1));
-        }
-        m_balls[i]->SetPosition(vec2(xPosition, y));
-        columnCount++;
-
-        if (columnCount >= totalPerColumn)
-        {
-            columnCount = 0;
-            totalPerColumn++;
-            xPosition += NORMAL_BALLS_DIST_BETWEEN;
-        }
+        m_holeInstanceCount = 0;
+        m_ballInstanceCount = 0;
+        return;
     }
-}
 
-void Game::CreateHoles()
-{
-    // gaurile de jos
-    m_holes.push_back(new Hole(vec2(HOLE_BIAS, HOLE_BIAS)));
-    m_holes.push_back(new Hole(vec2(Constants::GAME_WIDTH / 2.0f, HOLE_BIAS)));
-    m_holes.push_back(new Hole(vec2(Constants::GAME_WIDTH - HOLE_BIAS, HOLE_BIAS)));
-
-    // gaurile de sus
-    m_holes.push_back(new Hole(vec2(HOLE_BIAS, Constants::GAME_HEIGHT - HOLE_BIAS)));
-    m_holes.push_back(new Hole(vec2(Constants::GAME_WIDTH / 2.0f, Constants::GAME_HEIGHT - HOLE_BIAS)));
-    m_holes.push_back(new Hole(vec2(Constants::GAME_WIDTH - HOLE_BIAS, Constants::GAME_HEIGHT - HOLE_BIAS)));
-}
+    for (auto& hole : holes)
+        *instances++ = { hole->GetPosition(), Table::HOLE_RADIUS, vec3(0.0f, 0.0f, 0.0f), 0.0f };
 
-void Game::RenderHelperLines()
-{
-    glLineWidth(5.0f);
-    mat4 lineModel = LineModelFromTo(m_whiteBall->GetPosition(), m_mousePosition);
-
-    m_colorShader->Use();
-    m_colorShader->SetVec3("Color", vec3(1.0f, 1.0f, 1.0f));
-    m_colorShader->SetMatrix4("Projection", m_projectionMatrix);
-    m_colorShader->SetMatrix4("Model", lineModel);
-
-    glBindVertexArray(m_lineVao);
-    glDrawArrays(GL_LINES, 0, 2);
-
-    vec2 direction = normalize(m_whiteBall->GetPosition() - m_mousePosition);
-    vec2 ballPosition = m_whiteBall->GetPosition();
-    RayIntersection whiteBallHit = GetRayIntersection(ballPosition, direction, m_whiteBall);
-
-    mat4 lineModel2 = LineModelFromTo(m_whiteBall->GetPosition(), whiteBallHit.Point);
-
-    m_colorShader->Use();
-    m_colorShader->SetVec3("Color", vec3(1.0f, 1.0f, 1.0f));
-    m_colorShader->SetMatrix4("Projection", m_projectionMatrix);
-    m_colorShader->SetMatrix4("Model", lineModel2);
-
-    glBindVertexArray(m_lineVao);
-    glDrawArrays(GL_LINES, 0, 2);
-
-    vec2 beginLinePos = whiteBallHit.Point;
-    vec2 newDirection = reflect(direction, whiteBallHit.Normal);
-    Ball* excludeBall = nullptr;
-    if (whiteBallHit.Ball)
+    for (int slot = 0; slot < world.GetCount(); slot++)
     {
-        vec2 futureWhiteBallPos = whiteBallHit.Point - normalize(direction) * Ball::BALL_RADIUS;
-        vec2 fromOther = futureWhiteBallPos - whiteBallHit.Ball->GetPosition();
-
-        beginLinePos = whiteBallHit.Ball->GetPosition();
-        newDirection = -normalize(fromOther);
-        excludeBall = whiteBallHit.Ball;
+        float radius = world.GetRadius(slot);
+        float stripeRadius = world.IsSolid(slot) ? 0.0f : radius * 0.5f;
+        *instances++ = { world.GetInterpolatedPosition(slot, alpha), radius, world.GetColor(slot), stripeRadius };
     }
-    RayIntersection nextIntersection = GetRayIntersection(beginLinePos, newDirection, excludeBall);
-
-    mat4 lineModel3 = LineModelFromTo(beginLinePos, nextIntersection.Point);
 
-    m_colorShader->Use();
-    m_colorShader->SetVec3("Color", vec3(1.0f, 1.0f, 1.0f));
-    m_colorShader->SetMatrix4("Projection", m_projectionMatrix);
-    m_colorShader->SetMatrix4("Model", lineModel3);
+    int offset = m_streamBuffer->Unmap();
 
-    glBindVertexArray(m_lineVao);
-    glDrawArrays(GL_LINES, 0, 2);
+    glBindVertexArray(m_ballVao);
+    glBindVertexBuffer(BALL_INSTANCE_BINDING, m_streamBuffer->GetBuffer(), offset, sizeof(BallInstance));
 }
 
-Game::RayIntersection Game::GetRayIntersection(vec2 startPosition, vec2 direction, Ball* exceptionBall)
+// Linia de ochire (de la bila alba la mouse) si drumurile prezise de m_trajectoryPredictor, intr-un singur buffer.
+// Drumul bilei albe este alb, iar celelalte au culoarea bilei, deschisa ca sa se vada si cea neagra.
+void Game::RenderHelperLines()
 {
-    vec2 endPosition = startPosition + direction * 1000.0f;
-    vec2 closestIntersect = endPosition;
-    vec2 normal = vec2(0.0f, 1.0f);
-
-    RayIntersection result;
+    const BallWorld& world = m_table.GetWorld();
+    vec2 whiteBallPosition = world.GetPosition(world.GetSlot(m_table.GetWhiteBall()));
 
-    result.Ball = nullptr;
-
-    vec2 wallIntersection;
-
-    if (VerticalIntersect(startPosition, direction, 0.0f, wallIntersection))
-    {
-        if (length(wallIntersection - startPosition) < length(closestIntersect - startPosition))
-        {
-            closestIntersect = wallIntersection;
-            normal = vec2(1.0f, 0.0f);
-        }
-    }
+    int verticesCount = AIM_LINE_VERTICES_COUNT + m_trajectoryPredictor.GetPointCount();
 
-    if (VerticalIntersect(startPosition, direction, Constants::GAME_WIDTH, wallIntersection))
-    {
-        if (length(wallIntersection - startPosition) < length(closestIntersect - startPosition))
-        {
-            closestIntersect = wallIntersection;
-            normal = vec2(-1.0f, 0.0f);
-        }
-    }
-
-    if (Horizontalntersect(startPosition, direction, 0.0f, wallIntersection))
-    {
-        if (length(wallIntersection - startPosition) < length(closestIntersect - startPosition))
-        {
-            closestIntersect = wallIntersection;
-            normal = vec2(0.0f, 1.0f);
-        }
-    }
-
-    if (Horizontalntersect(startPosition, direction, Constants::GAME_HEIGHT, wallIntersection))
-    {
-        if (length(wallIntersection - startPosition) < length(closestIntersect - startPosition))
-        {
-            closestIntersect = wallIntersection;
-            normal = vec2(0.0f, -1.0f);
-        }
-    }
-
-    for (auto& ball : m_balls)
-    {
-        if (ball != exceptionBall)
-        {
-            vec2 intersection1;
-            vec2 intersection2;
-            vec2 ballPosition = ball->GetPosition();
-            int intersectionCount = FindLineCircleIntersections(ballPosition.x, ballPosition.y, Ball::BALL_RADIUS, startPosition, endPosition, intersection1, intersection2);
-
-            if (intersectionCount >= 1)
-            {
-                if (length(intersection1 - startPosition) < length(closestIntersect - startPosition) &&
-                    dot(direction, intersection1 - startPosition) > 0.0f)
-                {
-                    closestIntersect = intersection1;
-                    normal = normalize(intersection1 - ballPosition);
-                    result.Ball = ball;
-                }
-            }
-
-            if (intersectionCount >= 2)
-            {
-                if (length(intersection2 - startPosition) < length(closestIntersect - startPosition) &&
-                    dot(direction, intersection2 - startPosition) > 0.0f)
-                {
-                    closestIntersect = intersection2;
-                    normal = normalize(intersection2 - ballPosition);
-                    result.Ball = ball;
-                }
-            }
-        }
-    }
-
-    result.Point = closestIntersect;
-    result.Normal = normal;
-
-    return result;
-}
-
-//http://csharphelper.com/blog/2014/09/determine-where-a-line-intersects-a-circle-in-c/
-int Game::FindLineCircleIntersections(
-    float cx, float cy, float radius,
-    glm::vec2 point1, glm::vec2 point2,
-    vec2& intersection1, vec2& intersection2)
-{
-    float dx, dy, A, B, C, det, t;
-
-    dx = point2.x - point1.x;
-    dy = point2.y - point1.y;
+    vec2* vertices = (vec2*)m_streamBuffer->Map(sizeof(vec2) * verticesCount);
+    if (!vertices)
+        return;
 
-    A = dx * dx + dy * dy;
-    B = 2 * (dx * (point1.x - cx) + dy * (point1.y - cy));
-    C = (point1.x - cx) * (point1.x - cx) +
-        (point1.y - cy) * (point1.y - cy) -
-        radius * radius;
+    *vertices++ = whiteBallPosition;
+    *vertices++ = m_mousePosition;
 
-    det = B * B - 4 * A * C;
-    if ((A <= 0.0000001) || (det < 0))
+    for (int index = 0; index < m_trajectoryPredictor.GetPathCount(); index++)
     {
-        // No real solutions.
-        intersection1 = vec2(0.0f, 0.0f);
-        intersection2 = vec2(0.0f, 0.0f);
-        return 0;
+        for (auto& point : m_trajectoryPredictor.GetPath(index).Points)
+            *vertices++ = point;
     }
-    else if (det == 0)
-    {
-        // One solution.
-        t = -B / (2 * A);
-        intersection1 = vec2(point1.x + t * dx, point1.y + t * dy);
-        intersection2 = vec2(0.0f, 0.0f);
-        return 1;
-    }
-    else
-    {
-        // Two solutions.
-        t = (float)((-B + sqrtf(det)) / (2 * A));
-        intersection1 = vec2(point1.x + t * dx, point1.y + t * dy);
-        t = (float)((-B - sqrtf(det)) / (2 * A));
-        intersection2 = vec2(point1.x + t * dx, point1.y + t * dy);
-        return 2;
-    }
-}
 
-bool Game::VerticalIntersect(vec2 startPos, vec2 direction, float x1, vec2& intersection)
-{
-    intersection = vec2(0.0f, 0.0f);
-    if (abs(direction.x) < 0.01f)
-    {
-        return false;
-    }
+    int offset = m_streamBuffer->Unmap();
 
-    float t = (x1 - startPos.x) / direction.x;
-    float y = startPos.y + t * direction.y;
+    glLineWidth(5.0f);
 
-    vec2 intersectPoint = vec2(x1, y);
+    m_lineShader->Use();
+    m_lineShader->Set(m_lineProjection, m_projectionMatrix);
+    m_lineShader->Set(m_lineColor, vec3(1.0f, 1.0f, 1.0f));
 
-    if (dot(intersectPoint - startPos, direction) > 0.0f)
-    {
-        intersection = intersectPoint;
-        return true;
-    }
-    return false;
-}
+    glBindVertexArray(m_lineVao);
+    glBindVertexBuffer(0, m_streamBuffer->GetBuffer(), offset, sizeof(vec2));
+    glDrawArrays(GL_LINES, 0, AIM_LINE_VERTICES_COUNT);
 
-bool Game::Horizontalntersect(vec2 startPos, vec2 direction, float y1, vec2& intersection)
-{
-    intersection = vec2(0.0f, 0.0f);
-    if (abs(direction.y) < 0.01f)
+    int first = AIM_LINE_VERTICES_COUNT;
+    for (int index = 0; index < m_trajectoryPredictor.GetPathCount(); index++)
     {
-        return false;
-    }
-
-    float t = (y1 - startPos.y) / direction.y;
-    float x = startPos.x + t * direction.x;
+        const TrajectoryPredictor::Path& path = m_trajectoryPredictor.GetPath(index);
 
-    vec2 intersectPoint = vec2(x, y1);
+        vec3 color = world.GetColor(world.GetSlot(path.Handle));
+        m_lineShader->Set(m_lineColor, mix(color, vec3(1.0f, 1.0f, 1.0f), 0.5f));
 
-    if (dot(intersectPoint - startPos, direction) > 0.0f)
-    {
-        intersection = intersectPoint;
-        return true;
+        glDrawArrays(GL_LINE_STRIP, first, (int)path.Points.size());
+        first += (int)path.Points.size();
     }
-
-    return false;
 }
-
-mat4 Game::LineModelFromTo(vec2 from, vec2 to)
-{
-    vec2 direction = to - from;
-    float magnitude = length(direction);
-
-    float angle = -atan2(direction.x, direction.y);
-    return translate(mat4(1.0f), vec3(from.x, from.y, 0.0f)) * rotate(mat4(1.0f), angle, vec3(0.0f, 0.0f, 1.0f)) * scale(mat4(1.0f), vec3(magnitude, magnitude, 1.0f));
-}
\ No newline at end of file
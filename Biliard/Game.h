@@ -1,67 +1,47 @@
 #pragma once
 
+#include <future>
 #include <vector>
 #include <glm/glm.hpp>
 
 #include <GLFW/glfw3.h>
 
+#include "AiPlayer.h"
+#include "ReplayLog.h"
 #include "Shader.h"
-#include "Ball.h"
-#include "Hole.h"
+#include "StreamBuffer.h"
+#include "Table.h"
+#include "TrajectoryPredictor.h"
 
 class Game
 {
 private:
 
-    enum GameState
-    {
-        Playing,
-        Waiting,
-        Finished
-    };
-
-    enum Players
-    {
-        Player1,
-        Player2
-    };
-
     struct TableVertex
     {
         glm::vec3 Position;
         glm::vec3 Color;
     };
 
-    struct PlayerDetails
+    struct BallInstance
     {
-    public:
-
-        PlayerDetails();
-    
-    public:
-
-        int                Score;
-        bool               Dead;
-        bool               FinishedBalls;
-        std::vector<Ball*> AllowedBalls;
-    };
-
-    struct RayIntersection
-    {
-        glm::vec2 Point;
-        glm::vec2 Normal;
-        Ball*     Ball;
+        glm::vec2 Position;
+        float     Radius;
+        glm::vec3 Color;
+        float     StripeRadius;
     };
 
 private:
 
            const int   TABLE_INDICES_COUNT         = 6;
-           const float NORMAL_BALLS_OFFSET         = 100.0f;
-           const float NORMAL_BALLS_DIST_BETWEEN   = 50.0f;
-           const float HOLE_BIAS                   = 15.0f;
-           const float HOLE_RADIUS                 = 30.0f;
+           const int   MAX_PHYSICS_STEPS_PER_FRAME = 8;
 
-    static const int   BALL_OUTSIDE_VERTICES_COUNT = 20;
+    static const int   BALL_QUAD_VERTICES_COUNT    = 4;
+    static const int   BALL_INSTANCE_BINDING       = 1;
+    static const int   AIM_LINE_VERTICES_COUNT     = 2;
+    static const int   STREAM_BUFFER_FRAME_SIZE    = 64 * 1024;
+
+    static const Table::Players AI_PLAYER          = Table::Players::Player2;
 
 public:
 
@@ -75,9 +55,18 @@ public:
     void Update(float);
     void Render();
 
+    bool StartRecording(const std::string&);
+    void SetPrintStatistics(bool);
+
 private:
 
     void            OnMouseReleased();
+    void            Shoot(glm::vec2);
+
+    bool            IsAiTurn() const;
+    void            PlayAiTurn();
+
+    void            FixedUpdate(float);
 
     void            CreateTableBuffers();
     void            FreeTableBuffers();
@@ -88,21 +77,21 @@ private:
     void            CreateLineBuffers();
     void            FreeLineBuffers();
 
-    void            CreateBalls();
-    void            CreateHoles();
-
+    void            UploadBallInstances(float);
     void            RenderHelperLines();
 
-    RayIntersection GetRayIntersection(glm::vec2, glm::vec2, Ball* = nullptr);
-    int             FindLineCircleIntersections(float, float, float, glm::vec2, glm::vec2, glm::vec2&, glm::vec2&);
-    bool            VerticalIntersect(glm::vec2, glm::vec2, float, glm::vec2&);
-    bool            Horizontalntersect(glm::vec2, glm::vec2, float, glm::vec2&);
-    glm::mat4       LineModelFromTo(glm::vec2, glm::vec2);
-
 private:
 
-    Shader*            m_tableShader;
-    Shader*            m_colorShader;
+    Shader*                    m_tableShader;
+    Shader*                    m_ballShader;
+    Shader*                    m_lineShader;
+
+    Shader::Uniform<glm::mat4> m_tableProjection;
+    Shader::Uniform<glm::mat4> m_tableModel;
+    Shader::Uniform<glm::mat4> m_ballProjection;
+    Shader::Uniform<float>     m_ballPixelSize;
+    Shader::Uniform<glm::mat4> m_lineProjection;
+    Shader::Uniform<glm::vec3> m_lineColor;
 
     unsigned int       m_tableVbo;
     unsigned int       m_tableVao;
@@ -111,12 +100,24 @@ private:
     unsigned int       m_ballVbo;
     unsigned int       m_ballVao;
 
-    unsigned int       m_lineVbo;
     unsigned int       m_lineVao;
+
+    // instantele (intai gaurile, apoi bilele) si liniile ajutatoare sunt scrise aici in fiecare cadru
+    StreamBuffer*      m_streamBuffer;
+    int                m_holeInstanceCount;
+    int                m_ballInstanceCount;
     
-    std::vector<Ball*> m_balls;
-    Ball*              m_whiteBall;
-    std::vector<Hole*> m_holes;
+    Table              m_table;
+    AiPlayer           m_aiPlayer;
+
+    // lovitura calculatorului, planificata pe un alt thread; declarata dupa m_aiPlayer, ca sa fie asteptata inaintea lui
+    std::future<AiPlayer::ShotPlan> m_aiPlan;
+
+    // fiecare lovitura (a jucatorului sau a calculatorului) este adaugata aici; vezi ReplayPlayer
+    ReplayLog          m_replayLog;
+
+    // drumurile desenate cat timp se ocheste; recalculate doar cand se schimba lovitura sau masa
+    TrajectoryPredictor m_trajectoryPredictor;
 
     float              m_windowWidth;
     float              m_windowHeight;
@@ -125,8 +126,10 @@ private:
     glm::vec2          m_mousePosition;
 
     glm::mat4          m_projectionMatrix;
+    float              m_pixelSize;
+
+    float              m_physicsAccumulator;
 
-    GameState          m_gameState;
-    Players            m_currentPlayer;
-    PlayerDetails      m_playerDetails[2];
+    // costul fiecarei lovituri si al planificarii calculatorului, scrise in consola doar la cerere
+    bool               m_printStatistics;
 };
\ No newline at end of file
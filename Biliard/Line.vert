@@ -0,0 +1,11 @@
+#version 430 core
+layout (location = 0) in vec3 VSInputPosition;
+
+uniform mat4 Projection;
+
+out vec3 FSInputColor;
+
+void main()
+{
+    gl_Position = Projection * vec4(VSInputPosition, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "glad/glad.h"
+
+#include "RenderBench.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <glm/glm.hpp>
+
+#include "Game.h"
+#include "Shader.h"
+
+using namespace std;
+using namespace glm;
+
+namespace
+{
+    const int FRAME_COUNT   = 1000;
+    const int UNIFORM_COUNT = 100000;
+
+    struct Timing
+    {
+        double Cpu;
+        double Total;
+    };
+
+    // Cpu este timpul apelurilor, Total include si asteptarea ca GPU-ul sa termine (glFinish).
+    template <typename Draw>
+    Timing Time(int count, Draw draw)
+    {
+        glFinish();
+
+        auto start = chrono::steady_clock::now();
+        for (int index = 0; index < count; index++)
+            draw(index);
+        auto submitted = chrono::steady_clock::now();
+
+        glFinish();
+        auto finished = chrono::steady_clock::now();
+
+        Timing timing;
+        timing.Cpu = chrono::duration<double>(submitted - start).count() / count;
+        timing.Total = chrono::duration<double>(finished - start).count() / count;
+
+        return timing;
+    }
+
+    void Print(const char* name, const Timing& timing, double scale, const char* unit)
+    {
+        cout << "  " << name << ": " << timing.Cpu * scale << " " << unit << " CPU, " << timing.Total * scale << " " << unit << " cu GPU" << endl;
+    }
+}
+
+void RunRenderBench(Game& game)
+{
+    cout << "Render: " << FRAME_COUNT << " cadre" << endl;
+    Print("Game::Render", Time(FRAME_COUNT, [&game](int) { game.Render(); }), 1e3, "ms pe cadru");
+
+    Shader shader("Line.vert", "Line.frag");
+    shader.Use();
+
+    int programId = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &programId);
+
+    Shader::Uniform<vec3> color = shader.GetUniform<vec3>("Color");
+
+    cout << "Uniform vec3: " << UNIFORM_COUNT << " setari" << endl;
+    Print("glGetUniformLocation", Time(UNIFORM_COUNT, [programId](int index)
+    {
+        glUniform3f(glGetUniformLocation(programId, string("Color").c_str()), (float)index, 0.0f, 0.0f);
+    }), 1e9, "ns");
+    Print("SetVec3 cu nume", Time(UNIFORM_COUNT, [&shader](int index) { shader.SetVec3("Color", vec3((float)index, 0.0f, 0.0f)); }), 1e9, "ns");
+    Print("Set cu handle", Time(UNIFORM_COUNT, [&shader, color](int index) { shader.Set(color, vec3((float)index, 0.0f, 0.0f)); }), 1e9, "ns");
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+class Game;
+
+// Costul pe CPU al unui cadru desenat de Game::Render si al unei setari de uniform pe cele trei cai: glGetUniformLocation
+// cu numele la fiecare apel (ca inainte de cache), varianta cu nume din Shader (cautare in tabela) si handle-ul tipizat.
+// Ruleaza cu fereastra ascunsa ("--bench-render"), fara SwapBuffers, si scrie rezultatele in consola.
+void RunRenderBench(Game&);
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <glm/gtc/type_ptr.hpp>
@@ -105,6 +106,8 @@ Shader::Shader(const string vertexPath, const string fragmentPath,
 
     glDeleteShader(vertex);
     glDeleteShader(fragment);
+
+    LoadUniforms();
 }
 
 void Shader::Use()
@@ -112,40 +115,116 @@ void Shader::Use()
     glUseProgram(m_programId);
 }
 
+template <>
+Shader::Uniform<bool> Shader::GetUniform<bool>(const string& name) const
+{
+    return Uniform<bool>{ FindUniform(name, GL_BOOL) };
+}
+
+template <>
+Shader::Uniform<int> Shader::GetUniform<int>(const string& name) const
+{
+    return Uniform<int>{ FindUniform(name, GL_INT) };
+}
+
+template <>
+Shader::Uniform<float> Shader::GetUniform<float>(const string& name) const
+{
+    return Uniform<float>{ FindUniform(name, GL_FLOAT) };
+}
+
+template <>
+Shader::Uniform<vec2> Shader::GetUniform<vec2>(const string& name) const
+{
+    return Uniform<vec2>{ FindUniform(name, GL_FLOAT_VEC2) };
+}
+
+template <>
+Shader::Uniform<vec3> Shader::GetUniform<vec3>(const string& name) const
+{
+    return Uniform<vec3>{ FindUniform(name, GL_FLOAT_VEC3) };
+}
+
+template <>
+Shader::Uniform<vec4> Shader::GetUniform<vec4>(const string& name) const
+{
+    return Uniform<vec4>{ FindUniform(name, GL_FLOAT_VEC4) };
+}
+
+template <>
+Shader::Uniform<mat4> Shader::GetUniform<mat4>(const string& name) const
+{
+    return Uniform<mat4>{ FindUniform(name, GL_FLOAT_MAT4) };
+}
+
+void Shader::Set(Uniform<bool> uniform, bool value) const
+{
+    glUniform1i(uniform.Location, (int)value);
+}
+
+void Shader::Set(Uniform<int> uniform, int value) const
+{
+    glUniform1i(uniform.Location, value);
+}
+
+void Shader::Set(Uniform<float> uniform, float value) const
+{
+    glUniform1f(uniform.Location, value);
+}
+
+void Shader::Set(Uniform<vec2> uniform, const vec2& value) const
+{
+    glUniform2f(uniform.Location, value.x, value.y);
+}
+
+void Shader::Set(Uniform<vec3> uniform, const vec3& value) const
+{
+    glUniform3f(uniform.Location, value.x, value.y, value.z);
+}
+
+void Shader::Set(Uniform<vec4> uniform, const vec4& value) const
+{
+    glUniform4f(uniform.Location, value.x, value.y, value.z, value.w);
+}
+
+void Shader::Set(Uniform<mat4> uniform, const mat4& value) const
+{
+    glUniformMatrix4fv(uniform.Location, 1, GL_FALSE, value_ptr(value));
+}
+
 void Shader::SetBool(const string& name, bool value) const
 {
-    glUniform1i(glGetUniformLocation(m_programId, name.c_str()), (int)value);
+    Set(GetUniform<bool>(name), value);
 }
 
 void Shader::SetInt(const string& name, int value) const
 {
-    glUniform1i(glGetUniformLocation(m_programId, name.c_str()), value);
+    Set(GetUniform<int>(name), value);
 }
 
 void Shader::SetFloat(const string& name, float value) const
 {
-    glUniform1f(glGetUniformLocation(m_programId, name.c_str()), value);
+    Set(GetUniform<float>(name), value);
 }
 
 void Shader::SetVec2(const string& name, const vec2& value) const
 {
-    glUniform2f(glGetUniformLocation(m_programId, name.c_str()), value.x, value.y);
+    Set(GetUniform<vec2>(name), value);
 }
 
 void Shader::SetVec3(const string& name, const vec3& value) const
 {
-    glUniform3f(glGetUniformLocation(m_programId, name.c_str()), value.x, value.y, value.z);
+    Set(GetUniform<vec3>(name), value);
 }
 
 void Shader::SetVec4(const string& name, const vec4& value) const
 {
-    glUniform4f(glGetUniformLocation(m_programId, name.c_str()), value.x, value.y, value.z, value.w);
+    Set(GetUniform<vec4>(name), value);
 }
 
 void Shader::SetMatrix4(const string& name, mat4& value) const
 {
-    float* ptr = value_ptr(value);
-    glUniformMatrix4fv(glGetUniformLocation(m_programId, name.c_str()), 1, GL_FALSE, ptr);
+    Set(GetUniform<mat4>(name), value);
 }
 
 string Shader::ReadFile(const string filename)
@@ -165,3 +244,51 @@ string Shader::ReadFile(const string filename)
 
     return "";
 }
+
+// Tabela cu toate uniformele active, citita o singura data dupa link.
+void Shader::LoadUniforms()
+{
+    m_uniforms.clear();
+
+    int uniformCount = 0;
+    int maxNameLength = 0;
+    glGetProgramiv(m_programId, GL_ACTIVE_UNIFORMS, &uniformCount);
+    glGetProgramiv(m_programId, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+    string name(std::max(maxNameLength, 1), '\0');
+
+    for (int index = 0; index < uniformCount; index++)
+    {
+        int nameLength = 0;
+        int size = 0;
+        unsigned int type = 0;
+        glGetActiveUniform(m_programId, index, (int)name.size(), &nameLength, &size, &type, &name[0]);
+
+        // pentru vectori de uniforme GL intoarce numele cu "[0]" la sfarsit
+        string uniformName = name.substr(0, nameLength);
+        if (uniformName.size() > 3 && uniformName.compare(uniformName.size() - 3, 3, "[0]") == 0)
+            uniformName.resize(uniformName.size() - 3);
+
+        UniformInfo info;
+        info.Location = glGetUniformLocation(m_programId, uniformName.c_str());
+        info.Type = type;
+
+        if (info.Location != -1)
+            m_uniforms[uniformName] = info;
+    }
+}
+
+int Shader::FindUniform(const string& name, unsigned int type) const
+{
+    auto uniform = m_uniforms.find(name);
+    if (uniform == m_uniforms.end())
+        return -1;
+
+    if (uniform->second.Type != type)
+    {
+        cout << "ERROR::SHADER::UNIFORM_TYPE_MISMATCH " << name << endl;
+        return -1;
+    }
+
+    return uniform->second.Location;
+}
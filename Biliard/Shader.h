@@ -1,10 +1,29 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 #include <glm/glm.hpp>
 
 class Shader
 {
+public:
+
+    // Locatia unui uniform, luata o singura data dupa link. Tipul din sablon trebuie sa fie tipul din shader,
+    // asa ca un Set cu alt tip nu compileaza. Location este -1 daca uniformul nu exista sau are alt tip.
+    template <typename T>
+    struct Uniform
+    {
+        int Location;
+    };
+
+private:
+
+    struct UniformInfo
+    {
+        int          Location;
+        unsigned int Type;
+    };
+
 private:
 
     static const int SHADER_COMPILE_LOG_LENGTH = 512;
@@ -15,6 +34,18 @@ public:
 
     void Use();
 
+    template <typename T>
+    Uniform<T> GetUniform(const std::string&) const;
+
+    void Set(Uniform<bool>, bool)                      const;
+    void Set(Uniform<int>, int)                        const;
+    void Set(Uniform<float>, float)                    const;
+    void Set(Uniform<glm::vec2>, const glm::vec2&)     const;
+    void Set(Uniform<glm::vec3>, const glm::vec3&)     const;
+    void Set(Uniform<glm::vec4>, const glm::vec4&)     const;
+    void Set(Uniform<glm::mat4>, const glm::mat4&)     const;
+
+    // Variantele cu nume cauta uniformul in tabela de la link la fiecare apel; pentru desenari dese se folosesc handle-urile.
     void SetBool(const std::string&, bool)             const;
     void SetInt(const std::string&, int)               const;
     void SetFloat(const std::string&, float)           const;
@@ -27,7 +58,19 @@ private:
 
     std::string ReadFile(const std::string);
 
+    void        LoadUniforms();
+    int         FindUniform(const std::string&, unsigned int) const;
+
 private:
 
-    int m_programId;
-};
\ No newline at end of file
+    int                                          m_programId;
+    std::unordered_map<std::string, UniformInfo> m_uniforms;
+};
+
+template <> Shader::Uniform<bool>      Shader::GetUniform<bool>(const std::string&)      const;
+template <> Shader::Uniform<int>       Shader::GetUniform<int>(const std::string&)       const;
+template <> Shader::Uniform<float>     Shader::GetUniform<float>(const std::string&)     const;
+template <> Shader::Uniform<glm::vec2> Shader::GetUniform<glm::vec2>(const std::string&) const;
+template <> Shader::Uniform<glm::vec3> Shader::GetUniform<glm::vec3>(const std::string&) const;
+template <> Shader::Uniform<glm::vec4> Shader::GetUniform<glm::vec4>(const std::string&) const;
+template <> Shader::Uniform<glm::mat4> Shader::GetUniform<glm::mat4>(const std::string&) const;
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include "StreamBuffer.h"
+
+#include <algorithm>
+#include <GLFW/glfw3.h>
+
+using namespace std;
+
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
+namespace
+{
+    // glad este generat pentru GL 4.3, asa ca glBufferStorage (GL 4.4) este incarcat separat, daca exista.
+    typedef void (APIENTRYP BufferStorageProc)(GLenum, GLsizeiptr, const void*, GLbitfield);
+
+    BufferStorageProc LoadBufferStorage()
+    {
+        bool supported = GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 4) ||
+            glfwExtensionSupported("GL_ARB_buffer_storage");
+
+        return supported ? (BufferStorageProc)glfwGetProcAddress("glBufferStorage") : nullptr;
+    }
+}
+
+StreamBuffer::StreamBuffer(int frameSize) :
+    m_buffer(0),
+    m_frameSize(0),
+    m_frame(0),
+    m_frameOffset(0),
+    m_mappedOffset(-1),
+    m_persistent(false),
+    m_persistentData(nullptr)
+{
+    for (auto& fence : m_fences)
+        fence = nullptr;
+
+    Create(frameSize);
+}
+
+StreamBuffer::~StreamBuffer()
+{
+    Free();
+}
+
+// Asteapta pana cand GPU-ul a terminat cadrul care a scris ultima oara in zona curenta.
+// Daca cadrul are nevoie de mai mult de o zona, bufferul este recreat mai mare; asta se face doar aici,
+// ca datele deja trimise in cadrul curent sa nu ramana intr-un buffer sters.
+void StreamBuffer::BeginFrame(int frameSize)
+{
+    if (frameSize > m_frameSize)
+    {
+        // bufferul vechi poate fi inca folosit de GPU; se asteapta o singura data, doar cand datele cresc
+        glFinish();
+        Free();
+        Create(std::max(m_frameSize * 2, frameSize));
+        m_frame = 0;
+    }
+
+    GLsync& fence = m_fences[m_frame];
+    if (fence)
+    {
+        GLenum result = glClientWaitSync(fence, 0, 0);
+        while (result == GL_TIMEOUT_EXPIRED)
+            result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    m_frameOffset = 0;
+}
+
+void StreamBuffer::EndFrame()
+{
+    m_fences[m_frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_frame = (m_frame + 1) % FRAME_COUNT;
+    m_frameOffset = 0;
+}
+
+// Intoarce size octeti in zona cadrului curent, sau nullptr daca nu mai incap (vezi BeginFrame).
+// Datele trebuie scrise inainte de Unmap, care intoarce pozitia lor in buffer (pentru glBindVertexBuffer).
+void* StreamBuffer::Map(int size)
+{
+    int offset = (m_frameOffset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    if (offset + size > m_frameSize)
+        return nullptr;
+
+    m_mappedOffset = m_frame * m_frameSize + offset;
+    m_frameOffset = offset + size;
+
+    if (m_persistent)
+        return m_persistentData + m_mappedOffset;
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+    return glMapBufferRange(GL_ARRAY_BUFFER, m_mappedOffset, size,
+        GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+}
+
+int StreamBuffer::Unmap()
+{
+    if (!m_persistent)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+    }
+
+    int offset = m_mappedOffset;
+    m_mappedOffset = -1;
+
+    return offset;
+}
+
+unsigned int StreamBuffer::GetBuffer() const
+{
+    return m_buffer;
+}
+
+bool StreamBuffer::IsPersistent() const
+{
+    return m_persistent;
+}
+
+void StreamBuffer::Create(int frameSize)
+{
+    m_frameSize = (frameSize + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    m_frameOffset = 0;
+
+    int totalSize = m_frameSize * FRAME_COUNT;
+
+    glGenBuffers(1, &m_buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+
+    static BufferStorageProc bufferStorage = LoadBufferStorage();
+
+    if (bufferStorage)
+    {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        bufferStorage(GL_ARRAY_BUFFER, totalSize, nullptr, flags);
+        m_persistentData = (unsigned char*)glMapBufferRange(GL_ARRAY_BUFFER, 0, totalSize, flags);
+        m_persistent = m_persistentData != nullptr;
+    }
+
+    if (!m_persistent)
+        glBufferData(GL_ARRAY_BUFFER, totalSize, nullptr, GL_STREAM_DRAW);
+}
+
+void StreamBuffer::Free()
+{
+    for (auto& fence : m_fences)
+    {
+        if (fence)
+        {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_buffer);
+    if (m_persistent)
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDeleteBuffers(1, &m_buffer);
+
+    m_buffer = 0;
+    m_persistent = false;
+    m_persistentData = nullptr;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "glad/glad.h"
+
+// GL_ARRAY_BUFFER pentru date care se schimba in fiecare cadru (instante, linii), impartit in FRAME_COUNT zone.
+// Fiecare cadru scrie in zona lui; inainte de a o refolosi se asteapta fence-ul pus cand a fost desenata ultima oara,
+// asa ca GPU-ul nu citeste niciodata date suprascrise si nici driverul nu trebuie sa sincronizeze implicit.
+// Cu GL 4.4 / ARB_buffer_storage bufferul ramane mapat permanent; altfel fiecare Map foloseste glMapBufferRange
+// nesincronizat pe aceeasi zona.
+class StreamBuffer
+{
+public:
+
+    static const int FRAME_COUNT = 3;
+
+private:
+
+    static const int ALIGNMENT = 16;
+
+public:
+
+    StreamBuffer(int);
+    ~StreamBuffer();
+
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    void         BeginFrame(int = 0);
+    void         EndFrame();
+
+    void*        Map(int);
+    int          Unmap();
+
+    unsigned int GetBuffer()    const;
+    bool         IsPersistent() const;
+
+private:
+
+    void Create(int);
+    void Free();
+
+private:
+
+    unsigned int   m_buffer;
+    int            m_frameSize;
+    int            m_frame;
+    int            m_frameOffset;
+
+    int            m_mappedOffset;
+
+    bool           m_persistent;
+    unsigned char* m_persistentData;
+
+    GLsync         m_fences[FRAME_COUNT];
+};
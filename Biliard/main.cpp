@@ -1,9 +1,11 @@
 #include "glad/glad.h"
 
+#include <cstring>
 #include <iostream>
 #include <GLFW/glfw3.h>
 
 #include "Game.h"
+#include "RenderBench.h"
 
 using namespace std;
 
@@ -37,11 +39,19 @@ void ProcessInput(GLFWwindow* window)
 
 int main(int argc, char const* argv[])
 {
+    // "--bench-render" masoara desenarea cu fereastra ascunsa si iese (vezi RenderBench)
+    bool benchRender = false;
+    for (int arg = 1; arg < argc; arg++)
+        benchRender = benchRender || strcmp(argv[arg], "--bench-render") == 0;
+
     glfwInit();
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
+    if (benchRender)
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
     GLFWwindow* window = glfwCreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, "Biliard", NULL, NULL);
 
     if (window == NULL)
@@ -66,6 +76,22 @@ int main(int argc, char const* argv[])
 
     game = new Game(WINDOW_WIDTH, WINDOW_HEIGHT);
 
+    // "--replay <fisier>" inregistreaza meciul, ca sa poata fi refacut cu ReplayPlayer;
+    // "--stats" scrie in consola costul fiecarei lovituri si al planificarii calculatorului
+    for (int arg = 1; arg < argc; arg++)
+    {
+        if (strcmp(argv[arg], "--replay") == 0 && arg + 1 < argc)
+            game->StartRecording(argv[++arg]);
+        else if (strcmp(argv[arg], "--stats") == 0)
+            game->SetPrintStatistics(true);
+    }
+
+    if (benchRender)
+    {
+        RunRenderBench(*game);
+        glfwSetWindowShouldClose(window, true);
+    }
+
     float previousTime = glfwGetTime();
 
     while (!glfwWindowShouldClose(window))
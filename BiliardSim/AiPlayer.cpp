@@ -0,0 +1,277 @@
+#include "AiPlayer.h"
+
+#include <algorithm>
+#include <chrono>
+
+using namespace std;
+using namespace glm;
+
+const float AiPlayer::DEFAULT_TIME_BUDGET = 0.05f;
+const float AiPlayer::AIM_NOISE           = 0.01f;
+const float AiPlayer::POWER_NOISE         = 0.05f;
+const float AiPlayer::MIN_SHOT_POWER      = 80.0f;
+const float AiPlayer::MAX_SHOT_POWER      = 700.0f;
+
+AiPlayer::ShotPlan::ShotPlan() :
+    Velocity(0.0f, 0.0f),
+    ExpectedScore(0.0f),
+    Candidates(0),
+    EvaluatedShots(0),
+    Rounds(0),
+    Seconds(0.0f)
+{
+}
+
+AiPlayer::AiPlayer(int threadCount, unsigned int seed) :
+    m_evaluator(threadCount),
+    m_random(seed)
+{
+}
+
+// Timpul este verificat intre runde; o runda noua nu mai incepe daca, dupa durata celei anterioare, ar depasi bugetul.
+AiPlayer::ShotPlan AiPlayer::PlanShot(const Table& table, float timeBudget)
+{
+    auto start = chrono::steady_clock::now();
+
+    ShotPlan plan;
+
+    CreateCandidates(table);
+
+    float elapsed = 0.0f;
+    float lastRound = 0.0f;
+
+    do
+    {
+        if (plan.Rounds > 0)
+            AddRandomCandidates(RANDOM_CANDIDATES / 4);
+
+        if (FillRound() == 0)
+            break;
+
+        m_evaluator.Evaluate(table, m_shots, m_outcomes);
+
+        for (int shot = 0; shot < (int)m_shots.size(); shot++)
+        {
+            Candidate& candidate = m_candidates[m_shotCandidate[shot]];
+            candidate.ScoreSum += ScoreOutcome(table, m_outcomes[shot]);
+            candidate.Samples++;
+        }
+
+        plan.EvaluatedShots += (int)m_shots.size();
+        plan.Rounds++;
+
+        float now = chrono::duration<float>(chrono::steady_clock::now() - start).count();
+        lastRound = now - elapsed;
+        elapsed = now;
+
+    } while (elapsed + lastRound < timeBudget);
+
+    const Candidate* best = nullptr;
+    for (auto& candidate : m_candidates)
+    {
+        if (candidate.Samples == 0)
+            continue;
+        if (!best || MeanScore(candidate) > MeanScore(*best))
+            best = &candidate;
+    }
+
+    if (best)
+    {
+        plan.Velocity = vec2(cos(best->Angle), sin(best->Angle)) * best->Power;
+        plan.ExpectedScore = MeanScore(*best);
+    }
+
+    for (auto& candidate : m_candidates)
+        if (candidate.Samples > 0)
+            plan.Candidates++;
+
+    plan.Seconds = elapsed;
+
+    return plan;
+}
+
+void AiPlayer::CreateCandidates(const Table& table)
+{
+    m_candidates.clear();
+    m_rays.clear();
+
+    const BallWorld& world = table.GetWorld();
+    const Table::PlayerDetails& player = table.GetPlayerDetails(table.GetCurrentPlayer());
+
+    int whiteBall = table.GetWhiteBall();
+    vec2 whiteBallPosition = world.GetPosition(world.GetSlot(whiteBall));
+    float whiteBallRadius = world.GetRadius(world.GetSlot(whiteBall));
+
+    for (int slot = 0; slot < world.GetCount(); slot++)
+    {
+        int handle = world.GetHandle(slot);
+        if (handle == whiteBall || !world.OnBoard(slot))
+            continue;
+
+        bool target = world.GetBallType(slot) == Ball::BallType::Black ?
+            player.FinishedBalls :
+            (player.AllowedBalls & BallWorld::HandleBit(handle)) != 0;
+        if (!target)
+            continue;
+
+        // Bila alba trebuie sa ajunga exact in spatele bilei tinta, pe linia dintre gaura si bila tinta.
+        vec2 ballPosition = world.GetPosition(slot);
+        for (auto& hole : table.GetHoles())
+        {
+            vec2 toHole = hole->GetPosition() - ballPosition;
+            if (length(toHole) <= 0.0f)
+                continue;
+
+            vec2 ghostBall = ballPosition - normalize(toHole) * (whiteBallRadius + world.GetRadius(slot));
+            vec2 aim = ghostBall - whiteBallPosition;
+            if (length(aim) <= 0.0f)
+                continue;
+
+            // la un unghi de taiere de 90 de grade sau mai mult bila alba ar trebui sa treaca prin bila tinta
+            if (dot(aim, toHole) <= 0.0f)
+                continue;
+
+            BallKernels::Ray ray;
+            ray.Origin       = whiteBallPosition;
+            ray.Direction    = normalize(aim);
+            ray.MaxDistance  = length(aim);
+            ray.IgnoredIndex = slot;
+
+            m_rays.push_back(ray);
+        }
+    }
+
+    // Toate tintirile sunt verificate odata. Centrul bilei albe merge pe raza pana in punctul "ghost ball", iar o alta bila
+    // o atinge pe drum daca raza trece prin cercul ei marit cu raza bilei albe. Bila alba are raza 0, ca sa nu se loveasca
+    // pe ea insasi, iar bila tinta este ignorata de raza. Peretii nu conteaza, pentru ca nu pot fi intre doua bile de pe masa.
+    m_inflatedRadii.resize(world.GetCount());
+    for (int slot = 0; slot < world.GetCount(); slot++)
+        m_inflatedRadii[slot] = world.GetRadius(slot) + whiteBallRadius;
+    m_inflatedRadii[world.GetSlot(whiteBall)] = 0.0f;
+
+    BallKernels::Circles circles;
+    circles.CenterX = world.GetPositionsX();
+    circles.CenterY = world.GetPositionsY();
+    circles.Radius  = m_inflatedRadii.data();
+    circles.Count   = world.GetCount();
+
+    m_rayHits.resize(m_rays.size());
+    BallKernels::CastRays(m_rays.data(), (int)m_rays.size(), circles, m_rayHits.data(), table.GetPhysics().GetInstructionSet());
+
+    for (int index = 0; index < (int)m_rays.size(); index++)
+    {
+        // nicio bila mai aproape decat punctul "ghost ball"
+        if (m_rayHits[index].Index != -1)
+            continue;
+
+        vec2 direction = m_rays[index].Direction;
+        float angle = atan2(direction.y, direction.x);
+        for (int level = 0; level < POWER_LEVELS; level++)
+            AddCandidate(angle, mix(MIN_SHOT_POWER, MAX_SHOT_POWER, (level + 1.0f) / (POWER_LEVELS + 1.0f)));
+    }
+
+    AddRandomCandidates(RANDOM_CANDIDATES);
+}
+
+void AiPlayer::AddCandidate(float angle, float power)
+{
+    Candidate candidate;
+    candidate.Angle = angle;
+    candidate.Power = power;
+    candidate.ScoreSum = 0.0f;
+    candidate.Samples = 0;
+
+    m_candidates.push_back(candidate);
+}
+
+void AiPlayer::AddRandomCandidates(int count)
+{
+    uniform_real_distribution<float> angle(-pi<float>(), pi<float>());
+    uniform_real_distribution<float> power(MIN_SHOT_POWER, MAX_SHOT_POWER);
+
+    for (int i = 0; i < count; i++)
+        AddCandidate(angle(m_random), power(m_random));
+}
+
+// Pregateste loviturile unei runde: intai candidatii inca neincercati, apoi cei cu scorul mediu cel mai bun,
+// fiecare de SAMPLES_PER_ROUND ori cu zgomot pe unghi si pe putere. Intoarce numarul de lovituri.
+int AiPlayer::FillRound()
+{
+    m_order.resize(m_candidates.size());
+    for (int i = 0; i < (int)m_order.size(); i++)
+        m_order[i] = i;
+
+    sort(m_order.begin(), m_order.end(), [this](int first, int second)
+    {
+        const Candidate& a = m_candidates[first];
+        const Candidate& b = m_candidates[second];
+        if ((a.Samples == 0) != (b.Samples == 0))
+            return a.Samples == 0;
+        if (a.Samples == 0)
+            return first < second;
+        return MeanScore(a) > MeanScore(b);
+    });
+
+    normal_distribution<float> angleNoise(0.0f, AIM_NOISE);
+    normal_distribution<float> powerNoise(0.0f, POWER_NOISE);
+
+    m_shots.clear();
+    m_shotCandidate.clear();
+
+    int candidates = 0;
+    for (auto& index : m_order)
+    {
+        if (candidates >= CANDIDATES_PER_ROUND)
+            break;
+
+        const Candidate& candidate = m_candidates[index];
+        if (candidate.Samples >= MAX_SAMPLES_PER_CANDIDATE)
+            continue;
+
+        for (int sample = 0; sample < SAMPLES_PER_ROUND; sample++)
+        {
+            float angle = candidate.Angle + angleNoise(m_random);
+            float power = candidate.Power * std::max(0.0f, 1.0f + powerNoise(m_random));
+
+            m_shots.push_back(vec2(cos(angle), sin(angle)) * power);
+            m_shotCandidate.push_back(index);
+        }
+        candidates++;
+    }
+
+    return (int)m_shots.size();
+}
+
+float AiPlayer::ScoreOutcome(const Table& table, const ShotEvaluator::ShotOutcome& outcome) const
+{
+    const BallWorld& world = table.GetWorld();
+    const Table::PlayerDetails& player = table.GetPlayerDetails(table.GetCurrentPlayer());
+
+    if (outcome.Fouls & ShotEvaluator::Fouls::BlackBallFoul)
+        return -100.0f;
+
+    float score = 0.0f;
+    for (auto& handle : outcome.PocketedBalls)
+    {
+        if (world.GetBallType(world.GetSlot(handle)) == Ball::BallType::Black)
+            score += (outcome.Fouls & ShotEvaluator::Fouls::ScratchFoul) ? -100.0f : 100.0f;
+        else if (player.AllowedBalls & BallWorld::HandleBit(handle))
+            score += 1.0f;
+        else
+            score -= 1.0f;
+    }
+
+    if (outcome.Fouls & ShotEvaluator::Fouls::ScratchFoul)
+        score -= 2.0f;
+    if (outcome.Fouls & ShotEvaluator::Fouls::NoContactFoul)
+        score -= 1.0f;
+    if (outcome.Fouls & ShotEvaluator::Fouls::WrongBallFirstFoul)
+        score -= 0.5f;
+
+    return score;
+}
+
+float AiPlayer::MeanScore(const Candidate& candidate) const
+{
+    return candidate.ScoreSum / candidate.Samples;
+}
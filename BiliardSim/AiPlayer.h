@@ -0,0 +1,93 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+#include <random>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "BallKernels.h"
+#include "ShotEvaluator.h"
+#include "Table.h"
+
+// Jucator controlat de calculator. Alege lovitura prin Monte Carlo: genereaza directii si puteri candidate
+// (tintind bilele proprii spre gauri cu metoda "ghost ball", plus directii aleatoare), simuleaza fiecare candidat
+// de mai multe ori cu zgomot pe tintire si pastreaza candidatul cu cel mai bun scor mediu.
+// Cautarea se opreste cand se termina timpul alocat, dar are mereu un raspuns dupa prima runda.
+class AiPlayer
+{
+public:
+
+    struct ShotPlan
+    {
+    public:
+
+        ShotPlan();
+
+    public:
+
+        glm::vec2 Velocity;
+        float     ExpectedScore;
+        int       Candidates;
+        int       EvaluatedShots;
+        int       Rounds;
+        float     Seconds;
+    };
+
+public:
+
+    static const float DEFAULT_TIME_BUDGET;
+    static const float AIM_NOISE;
+    static const float POWER_NOISE;
+    static const float MIN_SHOT_POWER;
+    static const float MAX_SHOT_POWER;
+
+private:
+
+    static const int   POWER_LEVELS              = 4;
+    static const int   RANDOM_CANDIDATES         = 16;
+    static const int   SAMPLES_PER_ROUND         = 4;
+    static const int   MAX_SAMPLES_PER_CANDIDATE = 64;
+    static const int   CANDIDATES_PER_ROUND      = 32;
+
+public:
+
+    AiPlayer(int = 0, unsigned int = 0);
+
+    ShotPlan PlanShot(const Table&, float = DEFAULT_TIME_BUDGET);
+
+private:
+
+    struct Candidate
+    {
+        float Angle;
+        float Power;
+        float ScoreSum;
+        int   Samples;
+    };
+
+private:
+
+    void  CreateCandidates(const Table&);
+    void  AddCandidate(float, float);
+    void  AddRandomCandidates(int);
+    int   FillRound();
+    float ScoreOutcome(const Table&, const ShotEvaluator::ShotOutcome&) const;
+    float MeanScore(const Candidate&) const;
+
+private:
+
+    ShotEvaluator                            m_evaluator;
+    std::mt19937                             m_random;
+
+    std::vector<Candidate>                   m_candidates;
+    std::vector<int>                         m_order;
+    std::vector<glm::vec2>                   m_shots;
+    std::vector<int>                         m_shotCandidate;
+    std::vector<ShotEvaluator::ShotOutcome>  m_outcomes;
+
+    // tintirile "ghost ball" (fiecare ignora bila tinta) si razele bilelor marite cu raza bilei albe
+    std::vector<BallKernels::Ray>            m_rays;
+    std::vector<BallKernels::RayHit>         m_rayHits;
+    std::vector<float>                       m_inflatedRadii;
+};
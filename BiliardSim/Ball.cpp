@@ -0,0 +1,81 @@
+#include "Ball.h"
+
+#include "BallWorld.h"
+
+using namespace glm;
+
+const float Ball::WHITE_BALL_OFFSET      = 200.0f;
+const float Ball::BALL_MASS              = 10.0f;
+const float Ball::WALL_MASS              = 100.0f;
+const float Ball::RESTITUTION            = 0.98f;
+const float Ball::VELOCITY_BIAS          = 0.01f;
+const float Ball::FRICTION_MULTIPLIER    = 30.0f;
+const float Ball::VELOCITY_MULTIPLIER    = 5.0f;
+const float Ball::DISTANCE_TO_ENTER_HOLE = 25.0f;
+const float Ball::BALL_RADIUS            = 20.0f;
+
+Ball::Ball(BallWorld* world, int handle) :
+    m_world(world),
+    m_handle(handle)
+{
+}
+
+void Ball::SetPosition(vec2 position)
+{
+    m_world->SetPosition(m_world->GetSlot(m_handle), position);
+}
+
+void Ball::SetVelocity(vec2 velocity)
+{
+    m_world->SetVelocity(m_world->GetSlot(m_handle), velocity);
+}
+
+void Ball::SetRadius(float radius)
+{
+    m_world->SetRadius(m_world->GetSlot(m_handle), radius);
+}
+
+int Ball::GetHandle() const
+{
+    return m_handle;
+}
+
+vec2 Ball::GetPosition() const
+{
+    return m_world->GetPosition(m_world->GetSlot(m_handle));
+}
+
+vec2 Ball::GetVelocity() const
+{
+    return m_world->GetVelocity(m_world->GetSlot(m_handle));
+}
+
+float Ball::GetRadius() const
+{
+    return m_world->GetRadius(m_world->GetSlot(m_handle));
+}
+
+vec3 Ball::GetColor() const
+{
+    return m_world->GetColor(m_world->GetSlot(m_handle));
+}
+
+Ball::BallType Ball::GetBallType() const
+{
+    return m_world->GetBallType(m_world->GetSlot(m_handle));
+}
+
+bool Ball::IsSolid() const
+{
+    return m_world->IsSolid(m_world->GetSlot(m_handle));
+}
+
+bool Ball::IsStopped() const
+{
+    return m_world->IsStopped(m_world->GetSlot(m_handle));
+}
+
+bool Ball::OnBoard() const
+{
+    return m_world->OnBoard(m_world->GetSlot(m_handle));
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+#include <glm/glm.hpp>
+
+class BallWorld;
+
+// Vedere usoara peste o bila din BallWorld. Datele propriu-zise stau in vectorii din BallWorld,
+// iar bila este identificata printr-un handle care ramane valid cat timp bila este pe masa.
+class Ball
+{
+public:
+
+    enum class BallType
+    {
+        Normal,
+        White,
+        Black
+    };
+
+public:
+
+    static const float WHITE_BALL_OFFSET;
+    static const float BALL_MASS;
+    static const float WALL_MASS;
+    static const float RESTITUTION;
+    static const float VELOCITY_BIAS;
+    static const float FRICTION_MULTIPLIER;
+    static const float VELOCITY_MULTIPLIER;
+    static const float DISTANCE_TO_ENTER_HOLE;
+    static const float BALL_RADIUS;
+
+public:
+
+    Ball(BallWorld*, int);
+
+    void      SetPosition(glm::vec2);
+    void      SetVelocity(glm::vec2);
+    void      SetRadius(float);
+
+    int       GetHandle()   const;
+    glm::vec2 GetPosition() const;
+    glm::vec2 GetVelocity() const;
+    float     GetRadius()   const;
+    glm::vec3 GetColor()    const;
+    BallType  GetBallType() const;
+
+    bool      IsSolid()     const;
+    bool      IsStopped()   const;
+    bool      OnBoard()     const;
+
+private:
+
+    BallWorld* m_world;
+    int        m_handle;
+};
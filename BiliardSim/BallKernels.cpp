@@ -0,0 +1,827 @@
+#include "BallKernels.h"
+
+#include <cmath>
+
+#include "BallPhysics.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define BALL_KERNELS_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(BALL_KERNELS_X86) && !defined(_MSC_VER)
+#define TARGET_SSE    __attribute__((target("sse2")))
+#define TARGET_AVX2   __attribute__((target("avx2")))
+#define TARGET_AVX512 __attribute__((target("avx512f")))
+#if !defined(__clang__)
+// _mm512_sqrt_ps din immintrin.h al GCC 12 foloseste _mm512_undefined_ps(), pe care -Wmaybe-uninitialized
+// il raporteaza fals cand functia este inlinata (GCC bug 105593)
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#else
+#define TARGET_SSE
+#define TARGET_AVX2
+#define TARGET_AVX512
+#endif
+
+using namespace std;
+
+namespace
+{
+    struct FrictionArrays
+    {
+        float*         PositionX;
+        float*         PositionY;
+        float*         VelocityX;
+        float*         VelocityY;
+        unsigned char* Flags;
+    };
+
+    // Referinta pentru variantele vectoriale: BallPhysics<float>::Update pe fiecare bila treaza.
+    // Operatiile sunt length, normalize (v * (1 / sqrt(dot(v, v)))), frecare, testul de oprire si pozitia noua.
+    void UpdateFrictionScalar(float deltaTime, const FrictionArrays& arrays, int begin, int end)
+    {
+        for (int i = begin; i < end; i++)
+        {
+            if (arrays.Flags[i] & BallWorld::AsleepFlag)
+                continue;
+
+            BallPhysics<float>::State state;
+            state.Position = glm::vec2(arrays.PositionX[i], arrays.PositionY[i]);
+            state.Velocity = glm::vec2(arrays.VelocityX[i], arrays.VelocityY[i]);
+
+            BallPhysics<float>::Update(deltaTime, state);
+
+            if (state.Stopped)
+                arrays.Flags[i] |= BallWorld::StoppedFlag;
+            else
+                arrays.Flags[i] &= ~BallWorld::StoppedFlag;
+
+            arrays.VelocityX[i] = state.Velocity.x;
+            arrays.VelocityY[i] = state.Velocity.y;
+
+            arrays.PositionX[i] = state.Position.x;
+            arrays.PositionY[i] = state.Position.y;
+        }
+    }
+
+    // Loturile in care toate bilele dorm sunt sarite. Intr-un lot amestecat, bilele adormite au viteza zero
+    // si raman exact cum erau, asa ca nu trebuie mascate.
+    bool AllAsleep(const unsigned char* flags, int lanes)
+    {
+        for (int lane = 0; lane < lanes; lane++)
+        {
+            if (!(flags[lane] & BallWorld::AsleepFlag))
+                return false;
+        }
+        return true;
+    }
+
+    void WriteStoppedFlags(unsigned char* flags, int stoppedMask, int lanes)
+    {
+        for (int lane = 0; lane < lanes; lane++)
+        {
+            if (stoppedMask & (1 << lane))
+                flags[lane] |= BallWorld::StoppedFlag;
+            else
+                flags[lane] &= ~BallWorld::StoppedFlag;
+        }
+    }
+
+#ifdef BALL_KERNELS_X86
+
+    TARGET_SSE int UpdateFrictionSse(float deltaTime, const FrictionArrays& arrays, int count)
+    {
+        const __m128 zero         = _mm_setzero_ps();
+        const __m128 one          = _mm_set1_ps(1.0f);
+        const __m128 signMask     = _mm_set1_ps(-0.0f);
+        const __m128 bias         = _mm_set1_ps(Ball::VELOCITY_BIAS);
+        const __m128 friction     = _mm_set1_ps(Ball::FRICTION_MULTIPLIER);
+        const __m128 multiplier   = _mm_set1_ps(Ball::VELOCITY_MULTIPLIER);
+        const __m128 dt           = _mm_set1_ps(deltaTime);
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            if (AllAsleep(arrays.Flags + i, 4))
+                continue;
+
+            __m128 velocityX = _mm_loadu_ps(arrays.VelocityX + i);
+            __m128 velocityY = _mm_loadu_ps(arrays.VelocityY + i);
+
+            __m128 speed = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(velocityX, velocityX), _mm_mul_ps(velocityY, velocityY)));
+            __m128 moving = _mm_cmpge_ps(speed, bias);
+
+            __m128 inverseSpeed = _mm_div_ps(one, speed);
+            __m128 frictionX = _mm_mul_ps(_mm_xor_ps(_mm_mul_ps(velocityX, inverseSpeed), signMask), friction);
+            __m128 frictionY = _mm_mul_ps(_mm_xor_ps(_mm_mul_ps(velocityY, inverseSpeed), signMask), friction);
+
+            __m128 newVelocityX = _mm_add_ps(velocityX, _mm_mul_ps(frictionX, dt));
+            __m128 newVelocityY = _mm_add_ps(velocityY, _mm_mul_ps(frictionY, dt));
+
+            __m128 sameDirection = _mm_cmpgt_ps(_mm_add_ps(_mm_mul_ps(velocityX, newVelocityX), _mm_mul_ps(velocityY, newVelocityY)), zero);
+            __m128 keep = _mm_and_ps(moving, sameDirection);
+
+            newVelocityX = _mm_and_ps(newVelocityX, keep);
+            newVelocityY = _mm_and_ps(newVelocityY, keep);
+
+            __m128 newSpeed = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(newVelocityX, newVelocityX), _mm_mul_ps(newVelocityY, newVelocityY)));
+            WriteStoppedFlags(arrays.Flags + i, _mm_movemask_ps(_mm_cmplt_ps(newSpeed, bias)), 4);
+
+            _mm_storeu_ps(arrays.VelocityX + i, newVelocityX);
+            _mm_storeu_ps(arrays.VelocityY + i, newVelocityY);
+
+            __m128 positionX = _mm_loadu_ps(arrays.PositionX + i);
+            __m128 positionY = _mm_loadu_ps(arrays.PositionY + i);
+
+            _mm_storeu_ps(arrays.PositionX + i, _mm_add_ps(positionX, _mm_mul_ps(_mm_mul_ps(newVelocityX, dt), multiplier)));
+            _mm_storeu_ps(arrays.PositionY + i, _mm_add_ps(positionY, _mm_mul_ps(_mm_mul_ps(newVelocityY, dt), multiplier)));
+        }
+
+        return i;
+    }
+
+    TARGET_AVX2 int UpdateFrictionAvx2(float deltaTime, const FrictionArrays& arrays, int count)
+    {
+        const __m256 zero         = _mm256_setzero_ps();
+        const __m256 one          = _mm256_set1_ps(1.0f);
+        const __m256 signMask     = _mm256_set1_ps(-0.0f);
+        const __m256 bias         = _mm256_set1_ps(Ball::VELOCITY_BIAS);
+        const __m256 friction     = _mm256_set1_ps(Ball::FRICTION_MULTIPLIER);
+        const __m256 multiplier   = _mm256_set1_ps(Ball::VELOCITY_MULTIPLIER);
+        const __m256 dt           = _mm256_set1_ps(deltaTime);
+
+        int i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            if (AllAsleep(arrays.Flags + i, 8))
+                continue;
+
+            __m256 velocityX = _mm256_loadu_ps(arrays.VelocityX + i);
+            __m256 velocityY = _mm256_loadu_ps(arrays.VelocityY + i);
+
+            __m256 speed = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(velocityX, velocityX), _mm256_mul_ps(velocityY, velocityY)));
+            __m256 moving = _mm256_cmp_ps(speed, bias, _CMP_GE_OQ);
+
+            __m256 inverseSpeed = _mm256_div_ps(one, speed);
+            __m256 frictionX = _mm256_mul_ps(_mm256_xor_ps(_mm256_mul_ps(velocityX, inverseSpeed), signMask), friction);
+            __m256 frictionY = _mm256_mul_ps(_mm256_xor_ps(_mm256_mul_ps(velocityY, inverseSpeed), signMask), friction);
+
+            __m256 newVelocityX = _mm256_add_ps(velocityX, _mm256_mul_ps(frictionX, dt));
+            __m256 newVelocityY = _mm256_add_ps(velocityY, _mm256_mul_ps(frictionY, dt));
+
+            __m256 sameDirection = _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(velocityX, newVelocityX), _mm256_mul_ps(velocityY, newVelocityY)), zero, _CMP_GT_OQ);
+            __m256 keep = _mm256_and_ps(moving, sameDirection);
+
+            newVelocityX = _mm256_and_ps(newVelocityX, keep);
+            newVelocityY = _mm256_and_ps(newVelocityY, keep);
+
+            __m256 newSpeed = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(newVelocityX, newVelocityX), _mm256_mul_ps(newVelocityY, newVelocityY)));
+            WriteStoppedFlags(arrays.Flags + i, _mm256_movemask_ps(_mm256_cmp_ps(newSpeed, bias, _CMP_LT_OQ)), 8);
+
+            _mm256_storeu_ps(arrays.VelocityX + i, newVelocityX);
+            _mm256_storeu_ps(arrays.VelocityY + i, newVelocityY);
+
+            __m256 positionX = _mm256_loadu_ps(arrays.PositionX + i);
+            __m256 positionY = _mm256_loadu_ps(arrays.PositionY + i);
+
+            _mm256_storeu_ps(arrays.PositionX + i, _mm256_add_ps(positionX, _mm256_mul_ps(_mm256_mul_ps(newVelocityX, dt), multiplier)));
+            _mm256_storeu_ps(arrays.PositionY + i, _mm256_add_ps(positionY, _mm256_mul_ps(_mm256_mul_ps(newVelocityY, dt), multiplier)));
+        }
+
+        return i;
+    }
+
+    TARGET_AVX512 int UpdateFrictionAvx512(float deltaTime, const FrictionArrays& arrays, int count)
+    {
+        const __m512 zero         = _mm512_setzero_ps();
+        const __m512 one          = _mm512_set1_ps(1.0f);
+        const __m512 bias         = _mm512_set1_ps(Ball::VELOCITY_BIAS);
+        const __m512 friction     = _mm512_set1_ps(-Ball::FRICTION_MULTIPLIER);
+        const __m512 multiplier   = _mm512_set1_ps(Ball::VELOCITY_MULTIPLIER);
+        const __m512 dt           = _mm512_set1_ps(deltaTime);
+
+        int i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            if (AllAsleep(arrays.Flags + i, 16))
+                continue;
+
+            __m512 velocityX = _mm512_loadu_ps(arrays.VelocityX + i);
+            __m512 velocityY = _mm512_loadu_ps(arrays.VelocityY + i);
+
+            __m512 speed = _mm512_sqrt_ps(_mm512_add_ps(_mm512_mul_ps(velocityX, velocityX), _mm512_mul_ps(velocityY, velocityY)));
+            __mmask16 moving = _mm512_cmp_ps_mask(speed, bias, _CMP_GE_OQ);
+
+            // -(a) * b == a * (-b) exact, asa ca semnul e pus direct in constanta de frecare
+            __m512 inverseSpeed = _mm512_div_ps(one, speed);
+            __m512 frictionX = _mm512_mul_ps(_mm512_mul_ps(velocityX, inverseSpeed), friction);
+            __m512 frictionY = _mm512_mul_ps(_mm512_mul_ps(velocityY, inverseSpeed), friction);
+
+            __m512 newVelocityX = _mm512_add_ps(velocityX, _mm512_mul_ps(frictionX, dt));
+            __m512 newVelocityY = _mm512_add_ps(velocityY, _mm512_mul_ps(frictionY, dt));
+
+            __mmask16 sameDirection = _mm512_cmp_ps_mask(_mm512_add_ps(_mm512_mul_ps(velocityX, newVelocityX), _mm512_mul_ps(velocityY, newVelocityY)), zero, _CMP_GT_OQ);
+            __mmask16 keep = moving & sameDirection;
+
+            newVelocityX = _mm512_mask_blend_ps(keep, zero, newVelocityX);
+            newVelocityY = _mm512_mask_blend_ps(keep, zero, newVelocityY);
+
+            __m512 newSpeed = _mm512_sqrt_ps(_mm512_add_ps(_mm512_mul_ps(newVelocityX, newVelocityX), _mm512_mul_ps(newVelocityY, newVelocityY)));
+            WriteStoppedFlags(arrays.Flags + i, _mm512_cmp_ps_mask(newSpeed, bias, _CMP_LT_OQ), 16);
+
+            _mm512_storeu_ps(arrays.VelocityX + i, newVelocityX);
+            _mm512_storeu_ps(arrays.VelocityY + i, newVelocityY);
+
+            __m512 positionX = _mm512_loadu_ps(arrays.PositionX + i);
+            __m512 positionY = _mm512_loadu_ps(arrays.PositionY + i);
+
+            _mm512_storeu_ps(arrays.PositionX + i, _mm512_add_ps(positionX, _mm512_mul_ps(_mm512_mul_ps(newVelocityX, dt), multiplier)));
+            _mm512_storeu_ps(arrays.PositionY + i, _mm512_add_ps(positionY, _mm512_mul_ps(_mm512_mul_ps(newVelocityY, dt), multiplier)));
+        }
+
+        return i;
+    }
+
+#endif
+}
+
+namespace
+{
+    // Raza (cu directie unitara) vs un cerc: cel mai mic t > 0 pentru care originea + t * directia este pe cerc,
+    // sau -1 daca nu il atinge. Daca originea este in cerc, t este punctul de iesire.
+    float IntersectCircle(float originX, float originY, float directionX, float directionY,
+        float centerX, float centerY, float radiusSquared)
+    {
+        float mx = originX - centerX;
+        float my = originY - centerY;
+
+        float b = mx * directionX + my * directionY;
+        float c = (mx * mx + my * my) - radiusSquared;
+
+        float discriminant = b * b - c;
+        if (discriminant < 0.0f)
+            return -1.0f;
+
+        float root = sqrtf(discriminant);
+        float nearT = -b - root;
+
+        return nearT > 0.0f ? nearT : -b + root;
+    }
+
+    void CastRayScalar(const BallKernels::Ray& ray, const BallKernels::Circles& circles, int begin, BallKernels::RayHit& hit)
+    {
+
+        for (int i = begin; i < circles.Count; i++)
+        {
+            if (i == ray.IgnoredIndex)
+                continue;
+
+            float t = IntersectCircle(ray.Origin.x, ray.Origin.y, ray.Direction.x, ray.Direction.y,
+                circles.CenterX[i], circles.CenterY[i], circles.Radius[i] * circles.Radius[i]);
+
+            if (t > 0.0f && t < hit.Distance)
+            {
+                hit.Distance = t;
+                hit.Index = i;
+            }
+        }
+    }
+
+    // Fiecare linie a registrului a gasit cel mai apropiat cerc dintre indecsii ei (la egalitate, primul);
+    // dintre ele se alege distanta minima, apoi indexul minim, ca rezultatul sa fie acelasi ca in CastRayScalar.
+    void ReduceLanes(const float* distances, const int* indices, int lanes, BallKernels::RayHit& hit)
+    {
+        for (int lane = 0; lane < lanes; lane++)
+        {
+            if (indices[lane] == -1)
+                continue;
+
+            if (distances[lane] < hit.Distance || (distances[lane] == hit.Distance && indices[lane] < hit.Index))
+            {
+                hit.Distance = distances[lane];
+                hit.Index = indices[lane];
+            }
+        }
+    }
+
+    // Razele unui lot, transpuse ca fiecare camp sa se poata incarca direct intr-un registru.
+    struct RayLanes
+    {
+        alignas(64) float OriginX[16];
+        alignas(64) float OriginY[16];
+        alignas(64) float DirectionX[16];
+        alignas(64) float DirectionY[16];
+        alignas(64) float MaxDistance[16];
+        alignas(64) int   IgnoredIndex[16];
+    };
+
+    void LoadRayLanes(const BallKernels::Ray* rays, int lanes, RayLanes& rayLanes)
+    {
+        for (int lane = 0; lane < lanes; lane++)
+        {
+            rayLanes.OriginX[lane]      = rays[lane].Origin.x;
+            rayLanes.OriginY[lane]      = rays[lane].Origin.y;
+            rayLanes.DirectionX[lane]   = rays[lane].Direction.x;
+            rayLanes.DirectionY[lane]   = rays[lane].Direction.y;
+            rayLanes.MaxDistance[lane]  = rays[lane].MaxDistance;
+            rayLanes.IgnoredIndex[lane] = rays[lane].IgnoredIndex;
+        }
+    }
+
+    void StoreRayHits(const float* distances, const int* indices, int lanes, BallKernels::RayHit* hits)
+    {
+        for (int lane = 0; lane < lanes; lane++)
+        {
+            hits[lane].Index = indices[lane];
+            hits[lane].Distance = distances[lane];
+        }
+    }
+
+#ifdef BALL_KERNELS_X86
+
+    // CastRay: o raza, cate un cerc pe fiecare linie a registrului.
+    // CastRays: cate o raza pe fiecare linie, iar cercurile sunt parcurse pe rand (mai bine cand sunt multe raze si putine bile).
+    // Ambele fac aceleasi operatii ca IntersectCircle; un discriminant negativ da NaN in sqrt, dar linia este mascata.
+
+    TARGET_SSE int CastRaySse(const BallKernels::Ray& ray, const BallKernels::Circles& circles, BallKernels::RayHit& hit)
+    {
+        const __m128  zero          = _mm_setzero_ps();
+        const __m128  signMask      = _mm_set1_ps(-0.0f);
+        const __m128  originX       = _mm_set1_ps(ray.Origin.x);
+        const __m128  originY       = _mm_set1_ps(ray.Origin.y);
+        const __m128  directionX    = _mm_set1_ps(ray.Direction.x);
+        const __m128  directionY    = _mm_set1_ps(ray.Direction.y);
+        const __m128i ignoredIndex  = _mm_set1_epi32(ray.IgnoredIndex);
+        const __m128i indexStep     = _mm_set1_epi32(4);
+
+        __m128  bestDistance = _mm_set1_ps(hit.Distance);
+        __m128i bestIndex    = _mm_set1_epi32(-1);
+        __m128i index        = _mm_setr_epi32(0, 1, 2, 3);
+
+        int i = 0;
+        for (; i + 4 <= circles.Count; i += 4, index = _mm_add_epi32(index, indexStep))
+        {
+            __m128 mx = _mm_sub_ps(originX, _mm_loadu_ps(circles.CenterX + i));
+            __m128 my = _mm_sub_ps(originY, _mm_loadu_ps(circles.CenterY + i));
+
+            __m128 b = _mm_add_ps(_mm_mul_ps(mx, directionX), _mm_mul_ps(my, directionY));
+            __m128 radius = _mm_loadu_ps(circles.Radius + i);
+            __m128 radiusSquared = _mm_mul_ps(radius, radius);
+            __m128 c = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(mx, mx), _mm_mul_ps(my, my)), radiusSquared);
+
+            __m128 discriminant = _mm_sub_ps(_mm_mul_ps(b, b), c);
+            __m128 root = _mm_sqrt_ps(discriminant);
+
+            __m128 negativeB = _mm_xor_ps(b, signMask);
+            __m128 nearT = _mm_sub_ps(negativeB, root);
+            __m128 farT = _mm_add_ps(negativeB, root);
+
+            __m128 useNear = _mm_cmpgt_ps(nearT, zero);
+            __m128 t = _mm_or_ps(_mm_and_ps(useNear, nearT), _mm_andnot_ps(useNear, farT));
+
+            __m128 closer = _mm_and_ps(_mm_cmpge_ps(discriminant, zero), _mm_and_ps(_mm_cmpgt_ps(t, zero), _mm_cmplt_ps(t, bestDistance)));
+            closer = _mm_andnot_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(index, ignoredIndex)), closer);
+
+            __m128i closerIndex = _mm_castps_si128(closer);
+            bestDistance = _mm_or_ps(_mm_and_ps(closer, t), _mm_andnot_ps(closer, bestDistance));
+            bestIndex = _mm_or_si128(_mm_and_si128(closerIndex, index), _mm_andnot_si128(closerIndex, bestIndex));
+        }
+
+        alignas(16) float distances[4];
+        alignas(16) int   indices[4];
+        _mm_store_ps(distances, bestDistance);
+        _mm_store_si128((__m128i*)indices, bestIndex);
+        ReduceLanes(distances, indices, 4, hit);
+
+        return i;
+    }
+
+    TARGET_SSE int CastRaysSse(const BallKernels::Ray* rays, int rayCount, const BallKernels::Circles& circles, BallKernels::RayHit* hits)
+    {
+        const __m128 zero          = _mm_setzero_ps();
+        const __m128 signMask      = _mm_set1_ps(-0.0f);
+
+        RayLanes rayLanes;
+
+        int r = 0;
+        for (; r + 4 <= rayCount; r += 4)
+        {
+            LoadRayLanes(rays + r, 4, rayLanes);
+
+            __m128  originX      = _mm_load_ps(rayLanes.OriginX);
+            __m128  originY      = _mm_load_ps(rayLanes.OriginY);
+            __m128  directionX   = _mm_load_ps(rayLanes.DirectionX);
+            __m128  directionY   = _mm_load_ps(rayLanes.DirectionY);
+            __m128i ignoredIndex = _mm_load_si128((const __m128i*)rayLanes.IgnoredIndex);
+
+            __m128  bestDistance = _mm_load_ps(rayLanes.MaxDistance);
+            __m128i bestIndex    = _mm_set1_epi32(-1);
+
+            for (int i = 0; i < circles.Count; i++)
+            {
+                __m128i index = _mm_set1_epi32(i);
+
+                __m128 mx = _mm_sub_ps(originX, _mm_set1_ps(circles.CenterX[i]));
+                __m128 my = _mm_sub_ps(originY, _mm_set1_ps(circles.CenterY[i]));
+
+                __m128 b = _mm_add_ps(_mm_mul_ps(mx, directionX), _mm_mul_ps(my, directionY));
+                __m128 radiusSquared = _mm_set1_ps(circles.Radius[i] * circles.Radius[i]);
+                __m128 c = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(mx, mx), _mm_mul_ps(my, my)), radiusSquared);
+
+                __m128 discriminant = _mm_sub_ps(_mm_mul_ps(b, b), c);
+                __m128 root = _mm_sqrt_ps(discriminant);
+
+                __m128 negativeB = _mm_xor_ps(b, signMask);
+                __m128 nearT = _mm_sub_ps(negativeB, root);
+                __m128 farT = _mm_add_ps(negativeB, root);
+
+                __m128 useNear = _mm_cmpgt_ps(nearT, zero);
+                __m128 t = _mm_or_ps(_mm_and_ps(useNear, nearT), _mm_andnot_ps(useNear, farT));
+
+                __m128 closer = _mm_and_ps(_mm_cmpge_ps(discriminant, zero), _mm_and_ps(_mm_cmpgt_ps(t, zero), _mm_cmplt_ps(t, bestDistance)));
+                closer = _mm_andnot_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(index, ignoredIndex)), closer);
+
+                __m128i closerIndex = _mm_castps_si128(closer);
+                bestDistance = _mm_or_ps(_mm_and_ps(closer, t), _mm_andnot_ps(closer, bestDistance));
+                bestIndex = _mm_or_si128(_mm_and_si128(closerIndex, index), _mm_andnot_si128(closerIndex, bestIndex));
+            }
+
+            alignas(16) float distances[4];
+            alignas(16) int   indices[4];
+            _mm_store_ps(distances, bestDistance);
+            _mm_store_si128((__m128i*)indices, bestIndex);
+            StoreRayHits(distances, indices, 4, hits + r);
+        }
+
+        return r;
+    }
+
+    TARGET_AVX2 int CastRayAvx2(const BallKernels::Ray& ray, const BallKernels::Circles& circles, BallKernels::RayHit& hit)
+    {
+        const __m256  zero          = _mm256_setzero_ps();
+        const __m256  signMask      = _mm256_set1_ps(-0.0f);
+        const __m256  originX       = _mm256_set1_ps(ray.Origin.x);
+        const __m256  originY       = _mm256_set1_ps(ray.Origin.y);
+        const __m256  directionX    = _mm256_set1_ps(ray.Direction.x);
+        const __m256  directionY    = _mm256_set1_ps(ray.Direction.y);
+        const __m256i ignoredIndex  = _mm256_set1_epi32(ray.IgnoredIndex);
+        const __m256i indexStep     = _mm256_set1_epi32(8);
+
+        __m256  bestDistance = _mm256_set1_ps(hit.Distance);
+        __m256i bestIndex    = _mm256_set1_epi32(-1);
+        __m256i index        = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+        int i = 0;
+        for (; i + 8 <= circles.Count; i += 8, index = _mm256_add_epi32(index, indexStep))
+        {
+            __m256 mx = _mm256_sub_ps(originX, _mm256_loadu_ps(circles.CenterX + i));
+            __m256 my = _mm256_sub_ps(originY, _mm256_loadu_ps(circles.CenterY + i));
+
+            __m256 b = _mm256_add_ps(_mm256_mul_ps(mx, directionX), _mm256_mul_ps(my, directionY));
+            __m256 radius = _mm256_loadu_ps(circles.Radius + i);
+            __m256 radiusSquared = _mm256_mul_ps(radius, radius);
+            __m256 c = _mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(mx, mx), _mm256_mul_ps(my, my)), radiusSquared);
+
+            __m256 discriminant = _mm256_sub_ps(_mm256_mul_ps(b, b), c);
+            __m256 root = _mm256_sqrt_ps(discriminant);
+
+            __m256 negativeB = _mm256_xor_ps(b, signMask);
+            __m256 nearT = _mm256_sub_ps(negativeB, root);
+            __m256 farT = _mm256_add_ps(negativeB, root);
+
+            __m256 t = _mm256_blendv_ps(farT, nearT, _mm256_cmp_ps(nearT, zero, _CMP_GT_OQ));
+
+            __m256 closer = _mm256_and_ps(_mm256_cmp_ps(discriminant, zero, _CMP_GE_OQ),
+                _mm256_and_ps(_mm256_cmp_ps(t, zero, _CMP_GT_OQ), _mm256_cmp_ps(t, bestDistance, _CMP_LT_OQ)));
+            closer = _mm256_andnot_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(index, ignoredIndex)), closer);
+
+            bestDistance = _mm256_blendv_ps(bestDistance, t, closer);
+            bestIndex = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(bestIndex), _mm256_castsi256_ps(index), closer));
+        }
+
+        alignas(32) float distances[8];
+        alignas(32) int   indices[8];
+        _mm256_store_ps(distances, bestDistance);
+        _mm256_store_si256((__m256i*)indices, bestIndex);
+        ReduceLanes(distances, indices, 8, hit);
+
+        return i;
+    }
+
+    TARGET_AVX2 int CastRaysAvx2(const BallKernels::Ray* rays, int rayCount, const BallKernels::Circles& circles, BallKernels::RayHit* hits)
+    {
+        const __m256 zero          = _mm256_setzero_ps();
+        const __m256 signMask      = _mm256_set1_ps(-0.0f);
+
+        RayLanes rayLanes;
+
+        int r = 0;
+        for (; r + 8 <= rayCount; r += 8)
+        {
+            LoadRayLanes(rays + r, 8, rayLanes);
+
+            __m256  originX      = _mm256_load_ps(rayLanes.OriginX);
+            __m256  originY      = _mm256_load_ps(rayLanes.OriginY);
+            __m256  directionX   = _mm256_load_ps(rayLanes.DirectionX);
+            __m256  directionY   = _mm256_load_ps(rayLanes.DirectionY);
+            __m256i ignoredIndex = _mm256_load_si256((const __m256i*)rayLanes.IgnoredIndex);
+
+            __m256  bestDistance = _mm256_load_ps(rayLanes.MaxDistance);
+            __m256i bestIndex    = _mm256_set1_epi32(-1);
+
+            for (int i = 0; i < circles.Count; i++)
+            {
+                __m256i index = _mm256_set1_epi32(i);
+
+                __m256 mx = _mm256_sub_ps(originX, _mm256_set1_ps(circles.CenterX[i]));
+                __m256 my = _mm256_sub_ps(originY, _mm256_set1_ps(circles.CenterY[i]));
+
+                __m256 b = _mm256_add_ps(_mm256_mul_ps(mx, directionX), _mm256_mul_ps(my, directionY));
+                __m256 radiusSquared = _mm256_set1_ps(circles.Radius[i] * circles.Radius[i]);
+                __m256 c = _mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(mx, mx), _mm256_mul_ps(my, my)), radiusSquared);
+
+                __m256 discriminant = _mm256_sub_ps(_mm256_mul_ps(b, b), c);
+                __m256 root = _mm256_sqrt_ps(discriminant);
+
+                __m256 negativeB = _mm256_xor_ps(b, signMask);
+                __m256 nearT = _mm256_sub_ps(negativeB, root);
+                __m256 farT = _mm256_add_ps(negativeB, root);
+
+                __m256 t = _mm256_blendv_ps(farT, nearT, _mm256_cmp_ps(nearT, zero, _CMP_GT_OQ));
+
+                __m256 closer = _mm256_and_ps(_mm256_cmp_ps(discriminant, zero, _CMP_GE_OQ),
+                    _mm256_and_ps(_mm256_cmp_ps(t, zero, _CMP_GT_OQ), _mm256_cmp_ps(t, bestDistance, _CMP_LT_OQ)));
+                closer = _mm256_andnot_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(index, ignoredIndex)), closer);
+
+                bestDistance = _mm256_blendv_ps(bestDistance, t, closer);
+                bestIndex = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(bestIndex), _mm256_castsi256_ps(index), closer));
+            }
+
+            alignas(32) float distances[8];
+            alignas(32) int   indices[8];
+            _mm256_store_ps(distances, bestDistance);
+            _mm256_store_si256((__m256i*)indices, bestIndex);
+            StoreRayHits(distances, indices, 8, hits + r);
+        }
+
+        return r;
+    }
+
+    TARGET_AVX512 int CastRayAvx512(const BallKernels::Ray& ray, const BallKernels::Circles& circles, BallKernels::RayHit& hit)
+    {
+        const __m512  zero          = _mm512_setzero_ps();
+        const __m512  originX       = _mm512_set1_ps(ray.Origin.x);
+        const __m512  originY       = _mm512_set1_ps(ray.Origin.y);
+        const __m512  directionX    = _mm512_set1_ps(ray.Direction.x);
+        const __m512  directionY    = _mm512_set1_ps(ray.Direction.y);
+        const __m512i ignoredIndex  = _mm512_set1_epi32(ray.IgnoredIndex);
+        const __m512i indexStep     = _mm512_set1_epi32(16);
+
+        __m512  bestDistance = _mm512_set1_ps(hit.Distance);
+        __m512i bestIndex    = _mm512_set1_epi32(-1);
+        __m512i index        = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+        int i = 0;
+        for (; i + 16 <= circles.Count; i += 16, index = _mm512_add_epi32(index, indexStep))
+        {
+            __m512 mx = _mm512_sub_ps(originX, _mm512_loadu_ps(circles.CenterX + i));
+            __m512 my = _mm512_sub_ps(originY, _mm512_loadu_ps(circles.CenterY + i));
+
+            __m512 b = _mm512_add_ps(_mm512_mul_ps(mx, directionX), _mm512_mul_ps(my, directionY));
+            __m512 radius = _mm512_loadu_ps(circles.Radius + i);
+            __m512 radiusSquared = _mm512_mul_ps(radius, radius);
+            __m512 c = _mm512_sub_ps(_mm512_add_ps(_mm512_mul_ps(mx, mx), _mm512_mul_ps(my, my)), radiusSquared);
+
+            __m512 discriminant = _mm512_sub_ps(_mm512_mul_ps(b, b), c);
+            __m512 root = _mm512_sqrt_ps(discriminant);
+
+            // -b - root == 0 - b - root exact, asa ca negarea se face prin scadere din zero
+            __m512 negativeB = _mm512_sub_ps(zero, b);
+            __m512 nearT = _mm512_sub_ps(negativeB, root);
+            __m512 farT = _mm512_add_ps(negativeB, root);
+
+            __m512 t = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(nearT, zero, _CMP_GT_OQ), farT, nearT);
+
+            __mmask16 closer = _mm512_cmp_ps_mask(discriminant, zero, _CMP_GE_OQ) &
+                _mm512_cmp_ps_mask(t, zero, _CMP_GT_OQ) &
+                _mm512_cmp_ps_mask(t, bestDistance, _CMP_LT_OQ) &
+                ~_mm512_cmpeq_epi32_mask(index, ignoredIndex);
+
+            bestDistance = _mm512_mask_blend_ps(closer, bestDistance, t);
+            bestIndex = _mm512_mask_blend_epi32(closer, bestIndex, index);
+        }
+
+        alignas(64) float distances[16];
+        alignas(64) int   indices[16];
+        _mm512_store_ps(distances, bestDistance);
+        _mm512_store_si512(indices, bestIndex);
+        ReduceLanes(distances, indices, 16, hit);
+
+        return i;
+    }
+
+    TARGET_AVX512 int CastRaysAvx512(const BallKernels::Ray* rays, int rayCount, const BallKernels::Circles& circles, BallKernels::RayHit* hits)
+    {
+        const __m512 zero          = _mm512_setzero_ps();
+
+        RayLanes rayLanes;
+
+        int r = 0;
+        for (; r + 16 <= rayCount; r += 16)
+        {
+            LoadRayLanes(rays + r, 16, rayLanes);
+
+            __m512  originX      = _mm512_load_ps(rayLanes.OriginX);
+            __m512  originY      = _mm512_load_ps(rayLanes.OriginY);
+            __m512  directionX   = _mm512_load_ps(rayLanes.DirectionX);
+            __m512  directionY   = _mm512_load_ps(rayLanes.DirectionY);
+            __m512i ignoredIndex = _mm512_load_si512(rayLanes.IgnoredIndex);
+
+            __m512  bestDistance = _mm512_load_ps(rayLanes.MaxDistance);
+            __m512i bestIndex    = _mm512_set1_epi32(-1);
+
+            for (int i = 0; i < circles.Count; i++)
+            {
+                __m512i index = _mm512_set1_epi32(i);
+
+                __m512 mx = _mm512_sub_ps(originX, _mm512_set1_ps(circles.CenterX[i]));
+                __m512 my = _mm512_sub_ps(originY, _mm512_set1_ps(circles.CenterY[i]));
+
+                __m512 b = _mm512_add_ps(_mm512_mul_ps(mx, directionX), _mm512_mul_ps(my, directionY));
+                __m512 radiusSquared = _mm512_set1_ps(circles.Radius[i] * circles.Radius[i]);
+                __m512 c = _mm512_sub_ps(_mm512_add_ps(_mm512_mul_ps(mx, mx), _mm512_mul_ps(my, my)), radiusSquared);
+
+                __m512 discriminant = _mm512_sub_ps(_mm512_mul_ps(b, b), c);
+                __m512 root = _mm512_sqrt_ps(discriminant);
+
+                __m512 negativeB = _mm512_sub_ps(zero, b);
+                __m512 nearT = _mm512_sub_ps(negativeB, root);
+                __m512 farT = _mm512_add_ps(negativeB, root);
+
+                __m512 t = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(nearT, zero, _CMP_GT_OQ), farT, nearT);
+
+                __mmask16 closer = _mm512_cmp_ps_mask(discriminant, zero, _CMP_GE_OQ) &
+                    _mm512_cmp_ps_mask(t, zero, _CMP_GT_OQ) &
+                    _mm512_cmp_ps_mask(t, bestDistance, _CMP_LT_OQ) &
+                    ~_mm512_cmpeq_epi32_mask(index, ignoredIndex);
+
+                bestDistance = _mm512_mask_blend_ps(closer, bestDistance, t);
+                bestIndex = _mm512_mask_blend_epi32(closer, bestIndex, index);
+            }
+
+            alignas(64) float distances[16];
+            alignas(64) int   indices[16];
+            _mm512_store_ps(distances, bestDistance);
+            _mm512_store_si512(indices, bestIndex);
+            StoreRayHits(distances, indices, 16, hits + r);
+        }
+
+        return r;
+    }
+
+#endif
+}
+
+BallKernels::InstructionSet BallKernels::GetBestInstructionSet()
+{
+#if defined(BALL_KERNELS_X86) && defined(_MSC_VER)
+    int info[4];
+
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    bool sse2 = (info[3] & (1 << 26)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+
+    unsigned long long xcr0 = (osxsave && avx) ? _xgetbv(0) : 0;
+    bool osAvx = (xcr0 & 0x6) == 0x6;
+    bool osAvx512 = (xcr0 & 0xe6) == 0xe6;
+
+    bool avx2 = false;
+    bool avx512 = false;
+    if (maxLeaf >= 7)
+    {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+        avx512 = (info[1] & (1 << 16)) != 0;
+    }
+
+    if (avx512 && osAvx512)
+        return InstructionSet::AVX512;
+    if (avx2 && osAvx)
+        return InstructionSet::AVX2;
+    if (sse2)
+        return InstructionSet::SSE;
+#elif defined(BALL_KERNELS_X86)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f"))
+        return InstructionSet::AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return InstructionSet::AVX2;
+    if (__builtin_cpu_supports("sse2"))
+        return InstructionSet::SSE;
+#endif
+
+    return InstructionSet::Scalar;
+}
+
+void BallKernels::UpdateFriction(float deltaTime, BallWorld& world, InstructionSet instructionSet)
+{
+    FrictionArrays arrays;
+    arrays.PositionX = world.GetPositionsX();
+    arrays.PositionY = world.GetPositionsY();
+    arrays.VelocityX = world.GetVelocitiesX();
+    arrays.VelocityY = world.GetVelocitiesY();
+    arrays.Flags     = world.GetFlags();
+
+    int count = world.GetCount();
+    int processed = 0;
+
+#ifdef BALL_KERNELS_X86
+    switch (instructionSet)
+    {
+    case InstructionSet::AVX512:
+        processed = UpdateFrictionAvx512(deltaTime, arrays, count);
+        break;
+    case InstructionSet::AVX2:
+        processed = UpdateFrictionAvx2(deltaTime, arrays, count);
+        break;
+    case InstructionSet::SSE:
+        processed = UpdateFrictionSse(deltaTime, arrays, count);
+        break;
+    case InstructionSet::Scalar:
+        break;
+    }
+#endif
+
+    // restul bilelor care nu umplu un registru intreg
+    UpdateFrictionScalar(deltaTime, arrays, processed, count);
+}
+
+BallKernels::RayHit BallKernels::CastRay(const Ray& ray, const Circles& circles, InstructionSet instructionSet)
+{
+    RayHit hit;
+    hit.Index = -1;
+    hit.Distance = ray.MaxDistance;
+
+    int processed = 0;
+
+#ifdef BALL_KERNELS_X86
+    switch (instructionSet)
+    {
+    case InstructionSet::AVX512:
+        processed = CastRayAvx512(ray, circles, hit);
+        break;
+    case InstructionSet::AVX2:
+        processed = CastRayAvx2(ray, circles, hit);
+        break;
+    case InstructionSet::SSE:
+        processed = CastRaySse(ray, circles, hit);
+        break;
+    case InstructionSet::Scalar:
+        break;
+    }
+#endif
+
+    // restul cercurilor care nu umplu un registru intreg
+    CastRayScalar(ray, circles, processed, hit);
+
+    return hit;
+}
+
+void BallKernels::CastRays(const Ray* rays, int rayCount, const Circles& circles, RayHit* hits, InstructionSet instructionSet)
+{
+    int processed = 0;
+
+#ifdef BALL_KERNELS_X86
+    switch (instructionSet)
+    {
+    case InstructionSet::AVX512:
+        processed = CastRaysAvx512(rays, rayCount, circles, hits);
+        break;
+    case InstructionSet::AVX2:
+        processed = CastRaysAvx2(rays, rayCount, circles, hits);
+        break;
+    case InstructionSet::SSE:
+        processed = CastRaysSse(rays, rayCount, circles, hits);
+        break;
+    case InstructionSet::Scalar:
+        break;
+    }
+#endif
+
+    // razele ramase sunt testate una cate una
+    for (int r = processed; r < rayCount; r++)
+    {
+        hits[r].Index = -1;
+        hits[r].Distance = rays[r].MaxDistance;
+        CastRayScalar(rays[r], circles, 0, hits[r]);
+    }
+}
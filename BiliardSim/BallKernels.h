@@ -0,0 +1,59 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+#include <glm/glm.hpp>
+
+#include "BallWorld.h"
+
+// Bucle din pasul de fizica scrise pe loturi de bile, cu SSE / AVX2 / AVX-512.
+// Setul de instructiuni este ales la rulare; varianta Scalar este referinta, iar cele vectoriale
+// fac exact aceleasi operatii in aceeasi ordine, deci dau rezultate identice bit cu bit.
+class BallKernels
+{
+public:
+
+    enum class InstructionSet
+    {
+        Scalar,
+        SSE,
+        AVX2,
+        AVX512
+    };
+
+    // Cercuri cu centrele si razele in vectori separati (ca in BallWorld).
+    struct Circles
+    {
+        const float* CenterX;
+        const float* CenterY;
+        const float* Radius;
+        int          Count;
+    };
+
+    // Direction trebuie sa fie unitar, ca distanta intoarsa sa fie in unitatile mesei.
+    // Cercul IgnoredIndex (de obicei bila din care pleaca raza) nu este testat; -1 daca nu e cazul.
+    struct Ray
+    {
+        glm::vec2 Origin;
+        glm::vec2 Direction;
+        float     MaxDistance;
+        int       IgnoredIndex;
+    };
+
+    // Cel mai apropiat cerc atins la o distanta mai mica decat MaxDistance (la egalitate, cel cu indexul mai mic),
+    // sau Index = -1 si Distance = MaxDistance daca raza nu atinge nimic.
+    struct RayHit
+    {
+        int   Index;
+        float Distance;
+    };
+
+public:
+
+    static InstructionSet GetBestInstructionSet();
+
+    static void           UpdateFriction(float, BallWorld&, InstructionSet);
+
+    static RayHit         CastRay(const Ray&, const Circles&, InstructionSet);
+    static void           CastRays(const Ray*, int, const Circles&, RayHit*, InstructionSet);
+};
@@ -0,0 +1,151 @@
+#include "BallPhysics.h"
+
+#include <cmath>
+
+#include "Ball.h"
+
+using namespace std;
+using namespace glm;
+
+// Frecarea si apoi deplasarea, ca in pasul cu pas fix.
+template <typename T>
+void BallPhysics<T>::Update(T deltaTime, State& state)
+{
+    UpdateFriction(deltaTime, state);
+    Integrate(deltaTime, state);
+}
+
+// Bila incetineste cu FRICTION_MULTIPLIER in directia opusa vitezei; daca ar schimba sensul sau este sub VELOCITY_BIAS, se opreste.
+template <typename T>
+void BallPhysics<T>::UpdateFriction(T deltaTime, State& state)
+{
+    const T bias = T(Ball::VELOCITY_BIAS);
+    const T friction = T(Ball::FRICTION_MULTIPLIER);
+
+    Vector velocity = state.Velocity;
+
+    T speed = Length(velocity);
+
+    if (speed < bias)
+    {
+        velocity = Vector(T(0.0f), T(0.0f));
+    }
+    else
+    {
+        T inverseSpeed = T(1.0f) / speed;
+        Vector frictionForce = Vector(-(velocity.x * inverseSpeed) * friction, -(velocity.y * inverseSpeed) * friction);
+
+        Vector previousVelocity = velocity;
+        velocity = Vector(velocity.x + frictionForce.x * deltaTime, velocity.y + frictionForce.y * deltaTime);
+
+        if (Dot(previousVelocity, velocity) <= T(0.0f))
+            velocity = Vector(T(0.0f), T(0.0f));
+    }
+
+    state.Stopped = Length(velocity) < bias;
+    state.Velocity = velocity;
+}
+
+template <typename T>
+void BallPhysics<T>::Integrate(T deltaTime, State& state)
+{
+    const T multiplier = T(Ball::VELOCITY_MULTIPLIER);
+
+    state.Position.x = state.Position.x + state.Velocity.x * deltaTime * multiplier;
+    state.Position.y = state.Position.y + state.Velocity.y * deltaTime * multiplier;
+}
+
+// Metoda bazata pe: https://stackoverflow.com/questions/345838/ball-to-ball-collision-detection-and-handling
+// Bilele sunt mereu despartite; intoarce true daca s-au si apropiat, adica daca vitezele au fost schimbate.
+template <typename T>
+bool BallPhysics<T>::ResolveColission(State& state, State& other)
+{
+    Vector fromOther = state.Position - other.Position;
+    T dist = Length(fromOther);
+
+    Vector normal = fromOther * (T(1.0f) / dist);
+    Vector minTranslation = normal * ((state.Radius + other.Radius) - dist);
+
+    state.Position = state.Position + minTranslation * T(0.5f);
+    other.Position = other.Position + minTranslation * T(-0.5f);
+
+    return ApplyImpulse(state, other, normal);
+}
+
+// Peretele este dat prin normala lui (spre interiorul mesei) si cat de adanc a intrat bila in el. Bila este impinsa
+// inapoi de-a lungul normalei, chiar daca centrul a trecut deja de perete.
+template <typename T>
+bool BallPhysics<T>::ResolveCushion(State& state, Vector normal, T penetration)
+{
+    state.Position = state.Position + normal * penetration;
+
+    return ApplyImpulse(state, normal);
+}
+
+// Impulsul pentru doua bile in contact; normal este unitar, dinspre other spre state.
+// Toate bilele au masa BALL_MASS, indiferent de raza.
+template <typename T>
+bool BallPhysics<T>::ApplyImpulse(State& state, State& other, Vector normal)
+{
+    const T inverseMass = T(1.0f) / T(Ball::BALL_MASS);
+
+    Vector v = state.Velocity - other.Velocity;
+    T vn = Dot(v, normal);
+
+    if (vn > T(0.0f))
+        return false;
+
+    T i = (-(T(1.0f) + T(Ball::RESTITUTION)) * vn) / (T(2.0f) * inverseMass);
+    Vector impulse = normal * i;
+
+    state.Velocity = state.Velocity + impulse * inverseMass;
+    other.Velocity = other.Velocity - impulse * inverseMass;
+
+    return true;
+}
+
+// Acelasi impuls pentru un perete de masa WALL_MASS; normal este unitar, spre interiorul mesei.
+template <typename T>
+bool BallPhysics<T>::ApplyImpulse(State& state, Vector normal)
+{
+    T im1 = T(1.0f) / T(Ball::BALL_MASS);
+    T im2 = T(1.0f) / T(Ball::WALL_MASS);
+
+    Vector v = state.Velocity;
+    T vn = Dot(v, normal);
+
+    if (vn > T(0.0f))
+        return false;
+
+    T i = (-(T(1.0f) + T(Ball::RESTITUTION)) * vn) / (im1 + im2);
+    Vector impulse = normal * i;
+
+    state.Velocity = v + impulse * im1;
+
+    return true;
+}
+
+// Aceleasi operatii ca glm::dot, glm::length si glm::normalize, care accepta doar tipuri in virgula mobila.
+template <typename T>
+T BallPhysics<T>::Dot(Vector a, Vector b)
+{
+    return a.x * b.x + a.y * b.y;
+}
+
+template <typename T>
+T BallPhysics<T>::Length(Vector v)
+{
+    using std::sqrt;
+    return sqrt(Dot(v, v));
+}
+
+template <typename T>
+typename BallPhysics<T>::Vector BallPhysics<T>::Normalize(Vector v)
+{
+    using std::sqrt;
+    return v * (T(1.0f) / sqrt(Dot(v, v)));
+}
+
+template class BallPhysics<float>;
+template class BallPhysics<double>;
+template class BallPhysics<Fixed>;
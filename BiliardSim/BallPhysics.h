@@ -0,0 +1,47 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+#include <glm/glm.hpp>
+
+#include "Fixed.h"
+
+// Fizica unei singure bile (frecare, deplasare, impact cu alta bila sau cu peretele), scrisa o singura data
+// pentru orice tip numeric: float (jocul), double (referinta pentru precizie pe lovituri lungi) sau Fixed
+// (acelasi rezultat pe orice platforma). Operatiile sunt in aceeasi ordine ca inainte in Physics si BallKernels,
+// asa ca varianta float da exact rezultatele jocului. Definitiile sunt in BallPhysics.cpp, instantiate pentru cele trei tipuri.
+template <typename T>
+class BallPhysics
+{
+public:
+
+    typedef glm::vec<2, T> Vector;
+
+    struct State
+    {
+        Vector Position;
+        Vector Velocity;
+        T      Radius;
+        bool   Stopped;
+    };
+
+public:
+
+    static void   Update(T, State&);
+    static void   UpdateFriction(T, State&);
+    static void   Integrate(T, State&);
+
+    static bool   ResolveColission(State&, State&);
+    static bool   ResolveCushion(State&, Vector, T);
+
+    static bool   ApplyImpulse(State&, State&, Vector);
+    static bool   ApplyImpulse(State&, Vector);
+
+    static T      Dot(Vector, Vector);
+    static T      Length(Vector);
+    static Vector Normalize(Vector);
+};
+
+extern template class BallPhysics<float>;
+extern template class BallPhysics<double>;
+extern template class BallPhysics<Fixed>;
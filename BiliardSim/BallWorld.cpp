@@ -0,0 +1,496 @@
+#include "BallWorld.h"
+
+#include <cmath>
+#include <iostream>
+
+#include "Constants.h"
+
+using namespace std;
+using namespace glm;
+
+BallWorld::BallWorld() :
+    m_presentMask(0),
+    m_pocketedCount(0),
+    m_awakeCount(0)
+{
+}
+
+int BallWorld::Add(vec2 position, vec3 color, bool solid, Ball::BallType ballType, float radius)
+{
+    int slot = (int)m_positionX.size();
+    int handle = (int)m_slotOfHandle.size();
+
+    m_positionX.push_back(position.x);
+    m_positionY.push_back(position.y);
+    m_previousPositionX.push_back(position.x);
+    m_previousPositionY.push_back(position.y);
+    m_velocityX.push_back(0.0f);
+    m_velocityY.push_back(0.0f);
+    m_radius.push_back(radius);
+    m_flags.push_back((unsigned char)((solid ? SolidFlag : 0) | StoppedFlag | OnBoardFlag | AsleepFlag));
+    m_ballType.push_back(ballType);
+    m_color.push_back(color);
+
+    m_handleOfSlot.push_back(handle);
+    m_slotOfHandle.push_back(slot);
+    m_presentMask |= HandleBit(handle);
+
+    switch (ballType)
+    {
+    case Ball::BallType::White:
+        ResetWhite(slot);
+        break;
+    case Ball::BallType::Black:
+        m_color[slot] = vec3(0.0f, 0.0f, 0.0f);
+        break;
+    case Ball::BallType::Normal:
+        break;
+    }
+
+    return handle;
+}
+
+// Toate bilele care nu mai sunt pe masa sunt scoase intr-o singura trecere. Restul raman in aceeasi ordine, doar mutate
+// spre inceput, asa ca ordinea sloturilor nu depinde de momentul in care a fost bagata in gaura fiecare bila.
+void BallWorld::RemovePocketed()
+{
+    if (m_pocketedCount == 0)
+        return;
+
+    int count = GetCount();
+    int kept = 0;
+
+    for (int slot = 0; slot < count; slot++)
+    {
+        int handle = m_handleOfSlot[slot];
+
+        if (!OnBoard(slot))
+        {
+            // bilele scoase de pe masa dorm mereu, deci m_awakeCount ramane acelasi
+            m_slotOfHandle[handle] = -1;
+            m_presentMask &= ~HandleBit(handle);
+            continue;
+        }
+
+        if (kept != slot)
+        {
+            m_positionX[kept]         = m_positionX[slot];
+            m_positionY[kept]         = m_positionY[slot];
+            m_previousPositionX[kept] = m_previousPositionX[slot];
+            m_previousPositionY[kept] = m_previousPositionY[slot];
+            m_velocityX[kept]         = m_velocityX[slot];
+            m_velocityY[kept]         = m_velocityY[slot];
+            m_radius[kept]            = m_radius[slot];
+            m_flags[kept]             = m_flags[slot];
+            m_ballType[kept]          = m_ballType[slot];
+            m_color[kept]             = m_color[slot];
+            m_handleOfSlot[kept]      = handle;
+
+            m_slotOfHandle[handle] = kept;
+        }
+
+        kept++;
+    }
+
+    m_positionX.resize(kept);
+    m_positionY.resize(kept);
+    m_previousPositionX.resize(kept);
+    m_previousPositionY.resize(kept);
+    m_velocityX.resize(kept);
+    m_velocityY.resize(kept);
+    m_radius.resize(kept);
+    m_flags.resize(kept);
+    m_ballType.resize(kept);
+    m_color.resize(kept);
+    m_handleOfSlot.resize(kept);
+
+    m_pocketedCount = 0;
+}
+
+Ball BallWorld::GetBall(int handle)
+{
+    return Ball(this, handle);
+}
+
+int BallWorld::GetCount() const
+{
+    return (int)m_positionX.size();
+}
+
+int BallWorld::GetHandleCount() const
+{
+    return (int)m_slotOfHandle.size();
+}
+
+int BallWorld::GetSlot(int handle) const
+{
+    return m_slotOfHandle[handle];
+}
+
+int BallWorld::GetHandle(int slot) const
+{
+    return m_handleOfSlot[slot];
+}
+
+BallWorld::BallMask BallWorld::GetPresentMask() const
+{
+    return m_presentMask;
+}
+
+// Bilele care au intrat intr-o gaura si inca nu au fost scoase cu RemovePocketed.
+int BallWorld::GetPocketedCount() const
+{
+    return m_pocketedCount;
+}
+
+// Bilele cu handle de la MAX_HANDLES in sus (de exemplu in simularile cu multe bile) nu apar in masca.
+BallWorld::BallMask BallWorld::HandleBit(int handle)
+{
+    return handle < MAX_HANDLES ? (BallMask)1 << handle : 0;
+}
+
+vec2 BallWorld::GetPosition(int slot) const
+{
+    return vec2(m_positionX[slot], m_positionY[slot]);
+}
+
+vec2 BallWorld::GetVelocity(int slot) const
+{
+    return vec2(m_velocityX[slot], m_velocityY[slot]);
+}
+
+float BallWorld::GetRadius(int slot) const
+{
+    return m_radius[slot];
+}
+
+vec3 BallWorld::GetColor(int slot) const
+{
+    return m_color[slot];
+}
+
+Ball::BallType BallWorld::GetBallType(int slot) const
+{
+    return m_ballType[slot];
+}
+
+bool BallWorld::IsSolid(int slot) const
+{
+    return (m_flags[slot] & SolidFlag) != 0;
+}
+
+bool BallWorld::IsStopped(int slot) const
+{
+    return (m_flags[slot] & StoppedFlag) != 0;
+}
+
+bool BallWorld::OnBoard(int slot) const
+{
+    return (m_flags[slot] & OnBoardFlag) != 0;
+}
+
+bool BallWorld::IsAsleep(int slot) const
+{
+    return (m_flags[slot] & AsleepFlag) != 0;
+}
+
+void BallWorld::SetPosition(int slot, vec2 position)
+{
+    m_positionX[slot] = position.x;
+    m_positionY[slot] = position.y;
+}
+
+void BallWorld::SetVelocity(int slot, vec2 velocity)
+{
+    m_velocityX[slot] = velocity.x;
+    m_velocityY[slot] = velocity.y;
+
+    // o bila adormita are mereu viteza +0, ca BallKernels sa o poata lasa neatinsa si in loturile vectoriale (nu -0)
+    if (velocity.x != 0.0f || velocity.y != 0.0f)
+        Wake(slot);
+    else if (IsAsleep(slot))
+        m_velocityX[slot] = m_velocityY[slot] = 0.0f;
+}
+
+void BallWorld::SetRadius(int slot, float radius)
+{
+    m_radius[slot] = radius;
+}
+
+void BallWorld::SetStopped(int slot, bool stopped)
+{
+    SetFlag(slot, StoppedFlag, stopped);
+}
+
+void BallWorld::SetOnBoard(int slot, bool onBoard)
+{
+    if (!onBoard)
+        Sleep(slot);
+
+    if (onBoard != OnBoard(slot))
+        m_pocketedCount += onBoard ? -1 : 1;
+
+    SetFlag(slot, OnBoardFlag, onBoard);
+}
+
+// O bila adormita are viteza zero si StoppedFlag, asa ca pasul de frecare ar lasa-o exact cum este.
+void BallWorld::Sleep(int slot)
+{
+    if (IsAsleep(slot))
+        return;
+
+    m_velocityX[slot] = 0.0f;
+    m_velocityY[slot] = 0.0f;
+    m_flags[slot] |= StoppedFlag | AsleepFlag;
+    m_awakeCount--;
+}
+
+void BallWorld::Wake(int slot)
+{
+    if (!IsAsleep(slot) || !OnBoard(slot))
+        return;
+
+    m_flags[slot] &= ~AsleepFlag;
+    m_awakeCount++;
+}
+
+int BallWorld::GetAwakeCount() const
+{
+    return m_awakeCount;
+}
+
+void BallWorld::ResetWhite(int slot)
+{
+    m_color[slot] = vec3(1.0f, 1.0f, 1.0f);
+    SetPosition(slot, vec2(Constants::GAME_WIDTH / 2.0f - Ball::WHITE_BALL_OFFSET, Constants::GAME_HEIGHT / 2.0f));
+    SetVelocity(slot, vec2(0.0f, 0.0f));
+
+    // bila alba este teleportata, nu trebuie interpolata dinspre gaura
+    m_previousPositionX[slot] = m_positionX[slot];
+    m_previousPositionY[slot] = m_positionY[slot];
+}
+
+// Tot ce influenteaza simularea, in ordinea sloturilor. Pozitiile anterioare si culorile sunt doar pentru randare.
+void BallWorld::Hash(StateHash& hash) const
+{
+    hash.Add(GetCount());
+
+    for (int slot = 0; slot < GetCount(); slot++)
+    {
+        hash.Add(m_handleOfSlot[slot]);
+        hash.Add(m_positionX[slot]);
+        hash.Add(m_positionY[slot]);
+        hash.Add(m_velocityX[slot]);
+        hash.Add(m_velocityY[slot]);
+        hash.Add(m_radius[slot]);
+        hash.Add((int)m_flags[slot]);
+        hash.Add((int)m_ballType[slot]);
+    }
+}
+
+// TableState are loc pentru cel mult MAX_BALLS bile si MAX_HANDLES handle-uri; pentru o lume mai mare starea nu este scrisa deloc.
+bool BallWorld::SaveState(TableState& state) const
+{
+    if (GetCount() > TableState::MAX_BALLS)
+    {
+        cout << "ERROR::BALL_WORLD::TOO_MANY_BALLS_TO_SAVE " << GetCount() << endl;
+        return false;
+    }
+
+    if (GetHandleCount() > TableState::MAX_HANDLES)
+    {
+        cout << "ERROR::BALL_WORLD::TOO_MANY_HANDLES_TO_SAVE " << GetHandleCount() << endl;
+        return false;
+    }
+
+    state.BallCount = GetCount();
+    state.HandleCount = GetHandleCount();
+
+    for (int slot = 0; slot < GetCount(); slot++)
+    {
+        TableState::BallState& ball = state.Balls[slot];
+
+        ball.Position         = GetPosition(slot);
+        ball.PreviousPosition = vec2(m_previousPositionX[slot], m_previousPositionY[slot]);
+        ball.Velocity         = GetVelocity(slot);
+        ball.Radius           = m_radius[slot];
+        ball.Color            = m_color[slot];
+        ball.Type             = m_ballType[slot];
+        ball.Handle           = m_handleOfSlot[slot];
+        ball.Flags            = m_flags[slot];
+    }
+
+    return true;
+}
+
+// Vectorii sunt doar redimensionati, asa ca nu se aloca memorie daca lumea a avut deja cel putin atatea bile.
+// Toate campurile sunt verificate inainte de a schimba lumea; o stare invalida este refuzata. Numarul de bile treze
+// este numarat din flag-uri, nu luat din stare.
+bool BallWorld::RestoreState(const TableState& state)
+{
+    int count = state.BallCount;
+
+    if (count < 0 || count > TableState::MAX_BALLS)
+    {
+        cout << "ERROR::BALL_WORLD::INVALID_BALL_COUNT " << count << endl;
+        return false;
+    }
+
+    if (state.HandleCount < count || state.HandleCount > TableState::MAX_HANDLES)
+    {
+        cout << "ERROR::BALL_WORLD::INVALID_HANDLE_COUNT " << state.HandleCount << endl;
+        return false;
+    }
+
+    bool usedHandles[TableState::MAX_HANDLES] = {};
+
+    for (int slot = 0; slot < count; slot++)
+    {
+        const TableState::BallState& ball = state.Balls[slot];
+
+        if (ball.Handle < 0 || ball.Handle >= state.HandleCount || usedHandles[ball.Handle])
+        {
+            cout << "ERROR::BALL_WORLD::INVALID_HANDLE " << ball.Handle << endl;
+            return false;
+        }
+        usedHandles[ball.Handle] = true;
+
+        bool validType = ball.Type == Ball::BallType::Normal || ball.Type == Ball::BallType::White || ball.Type == Ball::BallType::Black;
+        bool validFlags = (ball.Flags & ~(SolidFlag | StoppedFlag | OnBoardFlag | AsleepFlag)) == 0;
+
+        // bilele scoase de pe masa dorm mereu, iar o bila adormita are viteza +0 (vezi SetVelocity)
+        bool asleep = (ball.Flags & AsleepFlag) != 0;
+        bool consistent = ((ball.Flags & OnBoardFlag) || asleep) && (!asleep || (ball.Velocity.x == 0.0f && ball.Velocity.y == 0.0f));
+
+        bool finite = std::isfinite(ball.Position.x) && std::isfinite(ball.Position.y) &&
+                      std::isfinite(ball.PreviousPosition.x) && std::isfinite(ball.PreviousPosition.y) &&
+                      std::isfinite(ball.Velocity.x) && std::isfinite(ball.Velocity.y) &&
+                      std::isfinite(ball.Radius) && ball.Radius > 0.0f;
+
+        if (!validType || !validFlags || !consistent || !finite)
+        {
+            cout << "ERROR::BALL_WORLD::INVALID_BALL " << ball.Handle << endl;
+            return false;
+        }
+    }
+
+    m_positionX.resize(count);
+    m_positionY.resize(count);
+    m_previousPositionX.resize(count);
+    m_previousPositionY.resize(count);
+    m_velocityX.resize(count);
+    m_velocityY.resize(count);
+    m_radius.resize(count);
+    m_flags.resize(count);
+    m_ballType.resize(count);
+    m_color.resize(count);
+    m_handleOfSlot.resize(count);
+
+    m_slotOfHandle.assign(state.HandleCount, -1);
+    m_presentMask = 0;
+    m_pocketedCount = 0;
+    m_awakeCount = 0;
+
+    for (int slot = 0; slot < count; slot++)
+    {
+        const TableState::BallState& ball = state.Balls[slot];
+
+        m_positionX[slot]         = ball.Position.x;
+        m_positionY[slot]         = ball.Position.y;
+        m_previousPositionX[slot] = ball.PreviousPosition.x;
+        m_previousPositionY[slot] = ball.PreviousPosition.y;
+        m_velocityX[slot]         = ball.Velocity.x;
+        m_velocityY[slot]         = ball.Velocity.y;
+        m_radius[slot]            = ball.Radius;
+        m_flags[slot]             = ball.Flags;
+        m_ballType[slot]          = ball.Type;
+        m_color[slot]             = ball.Color;
+        m_handleOfSlot[slot]      = ball.Handle;
+
+        m_slotOfHandle[ball.Handle] = slot;
+        m_presentMask |= HandleBit(ball.Handle);
+
+        if (!(ball.Flags & OnBoardFlag))
+            m_pocketedCount++;
+
+        if (!(ball.Flags & AsleepFlag))
+            m_awakeCount++;
+    }
+
+    return true;
+}
+
+void BallWorld::StorePreviousPositions()
+{
+    m_previousPositionX = m_positionX;
+    m_previousPositionY = m_positionY;
+}
+
+vec2 BallWorld::GetInterpolatedPosition(int slot, float alpha) const
+{
+    vec2 previousPosition = vec2(m_previousPositionX[slot], m_previousPositionY[slot]);
+    return mix(previousPosition, GetPosition(slot), alpha);
+}
+
+float* BallWorld::GetPositionsX()
+{
+    return m_positionX.data();
+}
+
+float* BallWorld::GetPositionsY()
+{
+    return m_positionY.data();
+}
+
+float* BallWorld::GetVelocitiesX()
+{
+    return m_velocityX.data();
+}
+
+float* BallWorld::GetVelocitiesY()
+{
+    return m_velocityY.data();
+}
+
+unsigned char* BallWorld::GetFlags()
+{
+    return m_flags.data();
+}
+
+const float* BallWorld::GetPositionsX() const
+{
+    return m_positionX.data();
+}
+
+const float* BallWorld::GetPositionsY() const
+{
+    return m_positionY.data();
+}
+
+const float* BallWorld::GetVelocitiesX() const
+{
+    return m_velocityX.data();
+}
+
+const float* BallWorld::GetVelocitiesY() const
+{
+    return m_velocityY.data();
+}
+
+const float* BallWorld::GetRadii() const
+{
+    return m_radius.data();
+}
+
+const unsigned char* BallWorld::GetFlags() const
+{
+    return m_flags.data();
+}
+
+void BallWorld::SetFlag(int slot, BallFlags flag, bool value)
+{
+    if (value)
+        m_flags[slot] |= flag;
+    else
+        m_flags[slot] &= ~flag;
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Ball.h"
+#include "StateHash.h"
+#include "TableState.h"
+
+// Starea tuturor bilelor, tinuta ca structure-of-arrays. Bilele de pe masa ocupa sloturile [0, GetCount()),
+// in ordine compacta, astfel incat buclele din fizica si din randare merg liniar prin memorie.
+// Handle-urile intoarse de Add raman stabile; slotul unei bile se poate schimba cand alta bila este scoasa.
+// Bilele oprite sunt adormite (AsleepFlag) si sarite de fizica; o viteza nenula le trezeste. Bilele scoase de pe masa
+// dorm mereu, asa ca GetAwakeCount() == 0 inseamna ca toate bilele stau pe loc.
+// Bilele bagate in gauri raman prezente (fara OnBoardFlag) pana la RemovePocketed, care le scoate pe toate dupa flag.
+// Pe langa flag-uri, bilele prezente sunt tinute si ca masca de biti dupa handle, ca regulile jocului sa fie doar cateva
+// operatii pe biti. Masca are loc doar pentru primele MAX_HANDLES bile; simularea nu depinde de ea.
+class BallWorld
+{
+public:
+
+    enum BallFlags
+    {
+        SolidFlag   = 1 << 0,
+        StoppedFlag = 1 << 1,
+        OnBoardFlag = 1 << 2,
+        AsleepFlag  = 1 << 3
+    };
+
+    typedef unsigned int BallMask;
+
+public:
+
+    static const int MAX_HANDLES = 32;
+
+public:
+
+    BallWorld();
+
+    int            Add(glm::vec2, glm::vec3, bool, Ball::BallType = Ball::BallType::Normal, float = Ball::BALL_RADIUS);
+    void           RemovePocketed();
+
+    Ball           GetBall(int);
+
+    int            GetCount()        const;
+    int            GetHandleCount()  const;
+    int            GetSlot(int)      const;
+    int            GetHandle(int)    const;
+
+    BallMask       GetPresentMask()  const;
+    int            GetPocketedCount() const;
+    static BallMask HandleBit(int);
+
+    glm::vec2      GetPosition(int)  const;
+    glm::vec2      GetVelocity(int)  const;
+    float          GetRadius(int)    const;
+    glm::vec3      GetColor(int)     const;
+    Ball::BallType GetBallType(int)  const;
+
+    bool           IsSolid(int)      const;
+    bool           IsStopped(int)    const;
+    bool           OnBoard(int)      const;
+    bool           IsAsleep(int)     const;
+
+    void           SetPosition(int, glm::vec2);
+    void           SetVelocity(int, glm::vec2);
+    void           SetRadius(int, float);
+    void           SetStopped(int, bool);
+    void           SetOnBoard(int, bool);
+
+    void           Sleep(int);
+    void           Wake(int);
+    int            GetAwakeCount()   const;
+
+    void           ResetWhite(int);
+
+    void           Hash(StateHash&)  const;
+
+    bool           SaveState(TableState&) const;
+    bool           RestoreState(const TableState&);
+
+    void           StorePreviousPositions();
+    glm::vec2      GetInterpolatedPosition(int, float) const;
+
+    float*         GetPositionsX();
+    float*         GetPositionsY();
+    float*         GetVelocitiesX();
+    float*         GetVelocitiesY();
+    unsigned char* GetFlags();
+
+    const float*         GetPositionsX()   const;
+    const float*         GetPositionsY()   const;
+    const float*         GetVelocitiesX()  const;
+    const float*         GetVelocitiesY()  const;
+    const float*         GetRadii()        const;
+    const unsigned char* GetFlags()        const;
+
+private:
+
+    void SetFlag(int, BallFlags, bool);
+
+private:
+
+    std::vector<float>          m_positionX;
+    std::vector<float>          m_positionY;
+    std::vector<float>          m_previousPositionX;
+    std::vector<float>          m_previousPositionY;
+    std::vector<float>          m_velocityX;
+    std::vector<float>          m_velocityY;
+    std::vector<float>          m_radius;
+    std::vector<unsigned char>  m_flags;
+    std::vector<Ball::BallType> m_ballType;
+    std::vector<glm::vec3>      m_color;
+
+    std::vector<int>            m_handleOfSlot;
+    std::vector<int>            m_slotOfHandle;
+
+    BallMask                    m_presentMask;
+    int                         m_pocketedCount;
+
+    int                         m_awakeCount;
+};
@@ -0,0 +1,358 @@
+#include "ContactSolver.h"
+
+#include <algorithm>
+
+#include "Ball.h"
+#include "BallPhysics.h"
+#include "ThreadPool.h"
+
+using namespace std;
+using namespace glm;
+
+const float ContactSolver::CONTACT_MARGIN = 0.05f;
+const float ContactSolver::RESTING_SPEED  = 1.0f;
+
+ContactSolver::ContactSolver() :
+    m_batchCount(0)
+{
+    // ca RestoreState sa nu aloce pentru o masa obisnuita
+    m_cache.reserve(TableState::MAX_CACHED_CONTACTS);
+}
+
+// Aplica function fiecarui contact, lot dupa lot. Pool-ul poate fi nullptr; loturile mai mici decat MIN_PARALLEL_BATCH
+// sunt rezolvate pe thread-ul apelant, pentru ca pornirea workerilor ar costa mai mult decat contactele.
+template <typename Function>
+void ContactSolver::ForEachBatch(ThreadPool* pool, const Function& function)
+{
+    for (int batch = 0; batch < m_batchCount; batch++)
+    {
+        int begin = m_batchStart[batch];
+        int end = m_batchStart[batch + 1];
+
+        // lotul de dupa MAX_COLORS are bile comune, deci merge doar pe rand
+        if (pool == nullptr || batch == MAX_COLORS || end - begin < MIN_PARALLEL_BATCH)
+        {
+            for (int index = begin; index < end; index++)
+                function(m_contacts[m_order[index]]);
+            continue;
+        }
+
+        pool->ParallelFor(end - begin, PARALLEL_GRAIN, [&](int index, int)
+        {
+            function(m_contacts[m_order[begin + index]]);
+        });
+    }
+}
+
+// pairs contine handle-uri. Impulsurile pastrate de SolveIterative nu mai sunt valabile dupa un pas cu Solve.
+void ContactSolver::Solve(const vector<pair<int, int>>& pairs, BallWorld& world, ThreadPool* pool)
+{
+    Color(pairs, world);
+
+    ForEachBatch(pool, [&](Contact& contact)
+    {
+        SolveContact(contact, world);
+    });
+
+    m_cache.clear();
+}
+
+// Ordinea: impulsurile de la pasul trecut, iterations treceri pe viteze si la final o singura despartire a bilelor.
+// Fiecare trecere merge pe aceleasi loturi ca Solve, deci rezultatul nu depinde nici aici de numarul de thread-uri.
+void ContactSolver::SolveIterative(const vector<pair<int, int>>& pairs, BallWorld& world, ThreadPool* pool, int iterations)
+{
+    Color(pairs, world);
+
+    ForEachBatch(pool, [&](Contact& contact)
+    {
+        PrepareContact(contact, world);
+        WarmStart(contact, world);
+    });
+
+    for (int iteration = 0; iteration < iterations; iteration++)
+    {
+        ForEachBatch(pool, [&](Contact& contact)
+        {
+            SolveVelocity(contact, world);
+        });
+    }
+
+    ForEachBatch(pool, [&](Contact& contact)
+    {
+        SolvePosition(contact, world);
+    });
+
+    StoreImpulses(world);
+}
+
+// Uitat cand masa se opreste sau este adusa in alta stare, ca sa nu porneasca din impulsuri care nu mai corespund.
+void ContactSolver::Reset()
+{
+    m_cache.clear();
+}
+
+// Doar primele MAX_CACHED_CONTACTS contacte incap in TableState; restul pornesc de la zero dupa RestoreState.
+void ContactSolver::SaveState(TableState& state) const
+{
+    state.CachedContactCount = glm::min((int)m_cache.size(), (int)TableState::MAX_CACHED_CONTACTS);
+
+    for (int index = 0; index < state.CachedContactCount; index++)
+    {
+        state.CachedContacts[index].Handle = (int)(m_cache[index].Key >> 32);
+        state.CachedContacts[index].OtherHandle = (int)(m_cache[index].Key & 0xffffffffull);
+        state.CachedContacts[index].Impulse = m_cache[index].Impulse;
+    }
+}
+
+void ContactSolver::RestoreState(const TableState& state)
+{
+    m_cache.resize(state.CachedContactCount);
+
+    for (int index = 0; index < state.CachedContactCount; index++)
+    {
+        m_cache[index].Key = GetKey(state.CachedContacts[index].Handle, state.CachedContacts[index].OtherHandle);
+        m_cache[index].Impulse = state.CachedContacts[index].Impulse;
+    }
+}
+
+const vector<ContactSolver::Contact>& ContactSolver::GetContacts() const
+{
+    return m_contacts;
+}
+
+int ContactSolver::GetBatchCount() const
+{
+    return m_batchCount;
+}
+
+// Colorare greedy in ordinea perechilor, apoi sortare stabila dupa culoare (counting sort), ca in fiecare lot
+// perechile sa ramana in ordinea primita.
+void ContactSolver::Color(const vector<pair<int, int>>& pairs, BallWorld& world)
+{
+    if ((int)m_usedColors.size() < world.GetCount())
+        m_usedColors.resize(world.GetCount(), 0);
+
+    m_contacts.clear();
+    m_colorOfContact.clear();
+
+    // dupa WakeTouchedBalls, o bila adormita nu poate atinge o bila treaza
+    for (auto& colissionPair : pairs)
+    {
+        int slot = world.GetSlot(colissionPair.first);
+        int otherSlot = world.GetSlot(colissionPair.second);
+
+        if (world.IsAsleep(slot) || world.IsAsleep(otherSlot))
+            continue;
+
+        unsigned long long used = m_usedColors[slot] | m_usedColors[otherSlot];
+
+        int color = 0;
+        while (color < MAX_COLORS && (used & (1ull << color)))
+            color++;
+
+        if (color < MAX_COLORS)
+        {
+            m_usedColors[slot] |= 1ull << color;
+            m_usedColors[otherSlot] |= 1ull << color;
+        }
+
+        Contact contact;
+        contact.Slot = slot;
+        contact.OtherSlot = otherSlot;
+        contact.Touching = false;
+        contact.Approaching = false;
+
+        m_contacts.push_back(contact);
+        m_colorOfContact.push_back(color);
+    }
+
+    m_batchCount = 0;
+    m_batchStart.assign(MAX_COLORS + 2, 0);
+
+    for (int index = 0; index < (int)m_contacts.size(); index++)
+    {
+        int color = m_colorOfContact[index];
+        m_batchStart[color + 1]++;
+        m_batchCount = glm::max(m_batchCount, color + 1);
+
+        // doar sloturile atinse sunt curatate, ca o masa mare cu putine contacte sa nu fie parcursa toata
+        m_usedColors[m_contacts[index].Slot] = 0;
+        m_usedColors[m_contacts[index].OtherSlot] = 0;
+    }
+
+    for (int color = 0; color <= MAX_COLORS; color++)
+        m_batchStart[color + 1] += m_batchStart[color];
+
+    m_order.resize(m_contacts.size());
+
+    int placed[MAX_COLORS + 1] = {};
+    for (int index = 0; index < (int)m_contacts.size(); index++)
+    {
+        int color = m_colorOfContact[index];
+        m_order[m_batchStart[color] + placed[color]++] = index;
+    }
+}
+
+// Bilele sunt despartite daca se ating, iar vitezele se schimba doar daca se apropiau.
+// Scrie doar in sloturile perechii, asa ca perechile dintr-un lot pot rula pe thread-uri diferite.
+void ContactSolver::SolveContact(Contact& contact, BallWorld& world)
+{
+    int slot = contact.Slot;
+    int otherSlot = contact.OtherSlot;
+
+    vec2 dir = world.GetPosition(otherSlot) - world.GetPosition(slot);
+    contact.Touching = length(dir) <= world.GetRadius(slot) + world.GetRadius(otherSlot);
+
+    if (!contact.Touching)
+        return;
+
+    BallPhysics<float>::State state = { world.GetPosition(slot), world.GetVelocity(slot), world.GetRadius(slot), false };
+    BallPhysics<float>::State other = { world.GetPosition(otherSlot), world.GetVelocity(otherSlot), world.GetRadius(otherSlot), false };
+
+    contact.Approaching = BallPhysics<float>::ResolveColission(state, other);
+    contact.Position = state.Position;
+    contact.OtherPosition = other.Position;
+
+    world.SetPosition(slot, state.Position);
+    world.SetPosition(otherSlot, other.Position);
+
+    if (!contact.Approaching)
+        return;
+
+    world.SetVelocity(slot, state.Velocity);
+    world.SetVelocity(otherSlot, other.Velocity);
+}
+
+// Normala, cat trebuie sa ricoseze perechea si impulsul de la pasul trecut. Perechile la mai putin de CONTACT_MARGIN
+// sunt tratate ca lipite, ca o bila din grup despartita exact la suma razelor sa nu piarda impulsul din cauza rotunjirilor.
+void ContactSolver::PrepareContact(Contact& contact, const BallWorld& world) const
+{
+    int slot = contact.Slot;
+    int otherSlot = contact.OtherSlot;
+
+    vec2 fromOther = world.GetPosition(slot) - world.GetPosition(otherSlot);
+    float dist = length(fromOther);
+
+    contact.Touching = dist <= world.GetRadius(slot) + world.GetRadius(otherSlot) + CONTACT_MARGIN;
+    contact.Approaching = false;
+    contact.Position = world.GetPosition(slot);
+    contact.OtherPosition = world.GetPosition(otherSlot);
+    contact.Normal = fromOther * (1.0f / dist);
+    contact.Bounce = 0.0f;
+    contact.Impulse = 0.0f;
+
+    if (!contact.Touching)
+        return;
+
+    float vn = dot(world.GetVelocity(slot) - world.GetVelocity(otherSlot), contact.Normal);
+
+    // contactele de repaus nu ricoseaza, altfel bilele lipite ar sari una de pe alta la fiecare pas
+    contact.Approaching = vn < 0.0f;
+    if (vn < -RESTING_SPEED)
+        contact.Bounce = -Ball::RESTITUTION * vn;
+
+    unsigned long long key = GetKey(world.GetHandle(slot), world.GetHandle(otherSlot));
+    auto cached = lower_bound(m_cache.begin(), m_cache.end(), key, [](const CachedContact& entry, unsigned long long value)
+    {
+        return entry.Key < value;
+    });
+
+    if (cached != m_cache.end() && cached->Key == key)
+        contact.Impulse = cached->Impulse;
+}
+
+void ContactSolver::WarmStart(Contact& contact, BallWorld& world)
+{
+    if (!contact.Touching || contact.Impulse == 0.0f)
+        return;
+
+    vec2 impulse = contact.Normal * (contact.Impulse / Ball::BALL_MASS);
+
+    world.SetVelocity(contact.Slot, world.GetVelocity(contact.Slot) + impulse);
+    world.SetVelocity(contact.OtherSlot, world.GetVelocity(contact.OtherSlot) - impulse);
+}
+
+// Impulsul care aduce viteza relativa pe normala la Bounce, cu impulsul acumulat tinut pozitiv: bilele se pot doar impinge.
+// Masa efectiva a perechii este BALL_MASS / 2.
+void ContactSolver::SolveVelocity(Contact& contact, BallWorld& world)
+{
+    if (!contact.Touching)
+        return;
+
+    vec2 velocity = world.GetVelocity(contact.Slot);
+    vec2 otherVelocity = world.GetVelocity(contact.OtherSlot);
+
+    float vn = dot(velocity - otherVelocity, contact.Normal);
+    float lambda = Ball::BALL_MASS * 0.5f * (contact.Bounce - vn);
+
+    float accumulated = glm::max(contact.Impulse + lambda, 0.0f);
+    lambda = accumulated - contact.Impulse;
+    contact.Impulse = accumulated;
+
+    if (lambda == 0.0f)
+        return;
+
+    vec2 impulse = contact.Normal * (lambda / Ball::BALL_MASS);
+
+    world.SetVelocity(contact.Slot, velocity + impulse);
+    world.SetVelocity(contact.OtherSlot, otherVelocity - impulse);
+}
+
+// Bilele care se suprapun sunt despartite pe jumatate fiecare, ca in Solve.
+void ContactSolver::SolvePosition(Contact& contact, BallWorld& world)
+{
+    if (!contact.Touching)
+        return;
+
+    int slot = contact.Slot;
+    int otherSlot = contact.OtherSlot;
+
+    vec2 fromOther = world.GetPosition(slot) - world.GetPosition(otherSlot);
+    float dist = length(fromOther);
+    float penetration = world.GetRadius(slot) + world.GetRadius(otherSlot) - dist;
+
+    if (penetration > 0.0f)
+    {
+        vec2 minTranslation = fromOther * (penetration * 0.5f / dist);
+
+        world.SetPosition(slot, world.GetPosition(slot) + minTranslation);
+        world.SetPosition(otherSlot, world.GetPosition(otherSlot) - minTranslation);
+    }
+
+    contact.Position = world.GetPosition(slot);
+    contact.OtherPosition = world.GetPosition(otherSlot);
+}
+
+// Sunt pastrate doar contactele de repaus: impulsul unui ricoseu ar fi anulat oricum la pasul urmator, dar abia dupa
+// cateva treceri, timp in care ar impinge si vecinii.
+void ContactSolver::StoreImpulses(const BallWorld& world)
+{
+    m_nextCache.clear();
+
+    for (auto& contact : m_contacts)
+    {
+        if (!contact.Touching || contact.Bounce != 0.0f || contact.Impulse <= 0.0f)
+            continue;
+
+        CachedContact cached;
+        cached.Key = GetKey(world.GetHandle(contact.Slot), world.GetHandle(contact.OtherSlot));
+        cached.Impulse = contact.Impulse;
+
+        m_nextCache.push_back(cached);
+    }
+
+    sort(m_nextCache.begin(), m_nextCache.end(), [](const CachedContact& a, const CachedContact& b)
+    {
+        return a.Key < b.Key;
+    });
+
+    m_cache.swap(m_nextCache);
+}
+
+unsigned long long ContactSolver::GetKey(int handle, int otherHandle)
+{
+    if (handle > otherHandle)
+        swap(handle, otherHandle);
+
+    return ((unsigned long long)handle << 32) | (unsigned int)otherHandle;
+}
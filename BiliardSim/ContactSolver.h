@@ -0,0 +1,110 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+#include <vector>
+#include <utility>
+#include <glm/glm.hpp>
+
+#include "BallWorld.h"
+#include "TableState.h"
+
+class ThreadPool;
+
+// Rezolva contactele dintre bile pe loturi independente. Perechile sunt colorate greedy, in ordinea primita:
+// fiecare primeste cea mai mica culoare nefolosita inca de vreuna din cele doua bile, asa ca doua perechi de aceeasi
+// culoare nu au nicio bila comuna si pot fi rezolvate in paralel. Culorile sunt rezolvate una dupa alta.
+// Ordinea depinde doar de perechi si de colorare, nu de pool, deci rezultatul este acelasi pentru orice numar de
+// thread-uri (si fara pool).
+// Perechile care nu mai incap in MAX_COLORS culori sunt rezolvate la final, pe rand, in ordinea primita.
+// Solve rezolva fiecare pereche o singura data (despartire + impuls). SolveIterative face impulsuri secventiale:
+// mai multe treceri prin toate contactele, cu impulsul acumulat al fiecaruia limitat la valori pozitive, pornind de la
+// impulsul aceluiasi contact de la pasul trecut (warm starting), ca grupurile de bile lipite sa se aseze fara tremur.
+class ContactSolver
+{
+public:
+
+    // Rezultatul unei perechi; Position si OtherPosition sunt pozitiile de dupa despartire, daca bilele s-au atins.
+    // Normal (dinspre OtherSlot spre Slot), Bounce si Impulse sunt folosite doar de SolveIterative.
+    struct Contact
+    {
+        int       Slot;
+        int       OtherSlot;
+        bool      Touching;
+        bool      Approaching;
+        glm::vec2 Position;
+        glm::vec2 OtherPosition;
+        glm::vec2 Normal;
+        float     Bounce;
+        float     Impulse;
+    };
+
+public:
+
+    static const int   MAX_COLORS         = 64;
+    static const int   MIN_PARALLEL_BATCH = 512;
+    static const int   PARALLEL_GRAIN     = 128;
+    static const int   DEFAULT_ITERATIONS = 8;
+
+    static const float CONTACT_MARGIN;
+    static const float RESTING_SPEED;
+
+public:
+
+    ContactSolver();
+
+    void                        Solve(const std::vector<std::pair<int, int>>&, BallWorld&, ThreadPool*);
+    void                        SolveIterative(const std::vector<std::pair<int, int>>&, BallWorld&, ThreadPool*, int = DEFAULT_ITERATIONS);
+
+    void                        Reset();
+    void                        SaveState(TableState&) const;
+    void                        RestoreState(const TableState&);
+
+    const std::vector<Contact>& GetContacts()   const;
+    int                         GetBatchCount() const;
+
+private:
+
+    // impulsul unui contact la pasul trecut; Key are handle-ul mai mic in bitii de sus
+    struct CachedContact
+    {
+        unsigned long long Key;
+        float              Impulse;
+    };
+
+private:
+
+    void        Color(const std::vector<std::pair<int, int>>&, BallWorld&);
+
+    template <typename Function>
+    void        ForEachBatch(ThreadPool*, const Function&);
+
+    static void SolveContact(Contact&, BallWorld&);
+
+    void        PrepareContact(Contact&, const BallWorld&) const;
+    static void WarmStart(Contact&, BallWorld&);
+    static void SolveVelocity(Contact&, BallWorld&);
+    static void SolvePosition(Contact&, BallWorld&);
+    void        StoreImpulses(const BallWorld&);
+
+    static unsigned long long GetKey(int, int);
+
+private:
+
+    // perechile in ordinea primita, doar cele cu ambele bile treze
+    std::vector<Contact>            m_contacts;
+
+    // indicii din m_contacts grupati dupa culoare; lotul c este [m_batchStart[c], m_batchStart[c + 1])
+    std::vector<int>                m_order;
+    std::vector<int>                m_batchStart;
+    std::vector<int>                m_colorOfContact;
+
+    // culorile folosite deja de fiecare slot, cate un bit pe culoare
+    std::vector<unsigned long long> m_usedColors;
+
+    // impulsurile de la pasul trecut, sortate dupa Key
+    std::vector<CachedContact>      m_cache;
+    std::vector<CachedContact>      m_nextCache;
+
+    int                             m_batchCount;
+};
@@ -0,0 +1,520 @@
+#include "EventSolver.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "BallPhysics.h"
+#include "Constants.h"
+
+using namespace std;
+using namespace glm;
+
+const float EventSolver::CONTACT_EPSILON       = 0.01f;
+const int   EventSolver::MAX_ADVANCEMENT_STEPS = 32;
+const int   EventSolver::MAX_EVENTS_PER_UPDATE = 1024;
+const int   EventSolver::MAX_EVENTS_UNTIL_REST = 1000000;
+
+namespace
+{
+    const float NEVER = numeric_limits<float>::infinity();
+}
+
+// Evenimentele din acelasi moment sunt ordonate complet, ca ordinea lor sa nu depinda de implementarea heap-ului.
+bool EventSolver::Event::operator>(const Event& other) const
+{
+    if (Time != other.Time)
+        return Time > other.Time;
+    if (Slot != other.Slot)
+        return Slot > other.Slot;
+    if (Type != other.Type)
+        return Type > other.Type;
+    return Other > other.Other;
+}
+
+EventSolver::EventSolver() :
+    m_time(0.0f),
+    m_backlog(0.0f),
+    m_processedEvents(0)
+{
+}
+
+// Daca se atinge limita de evenimente, restul timpului ramane pentru apelurile urmatoare.
+void EventSolver::Update(float deltaTime, BallWorld& world, const vector<Hole*>& holes, ShotEvents& shotEvents)
+{
+    float duration = deltaTime + m_backlog;
+    m_backlog = duration - Simulate(duration, MAX_EVENTS_PER_UPDATE, world, holes, shotEvents);
+}
+
+// Daca nici dupa MAX_EVENTS_UNTIL_REST evenimente bilele nu s-au oprit, sunt lasate sa se opreasca fara alte impacturi.
+float EventSolver::UpdateUntilRest(BallWorld& world, const vector<Hole*>& holes, ShotEvents& shotEvents)
+{
+    float time = Simulate(NEVER, MAX_EVENTS_UNTIL_REST, world, holes, shotEvents);
+
+    // dupa ultimul impact bilele doar mai incetinesc pana se opresc
+    float remaining = 0.0f;
+    for (int slot = 0; slot < world.GetCount(); slot++)
+        if (world.OnBoard(slot))
+            remaining = std::max(remaining, TimeToStop(world.GetVelocity(slot)));
+
+    AdvanceAll(remaining, world);
+    StoreBalls(world);
+
+    m_events.clear();
+    m_time = 0.0f;
+    m_backlog = 0.0f;
+
+    return time + remaining;
+}
+
+int EventSolver::GetProcessedEventCount() const
+{
+    return m_processedEvents;
+}
+
+// Simuleaza cel mult duration si intoarce timpul simulat, mai mic doar daca s-a ajuns la maxEvents evenimente.
+// Pentru duration = NEVER simularea se opreste dupa ultimul impact, fara sa mai avanseze bilele pana la oprire.
+float EventSolver::Simulate(float duration, int maxEvents, BallWorld& world, const vector<Hole*>& holes, ShotEvents& shotEvents)
+{
+    Synchronize(world, holes);
+
+    m_processedEvents = 0;
+
+    float start = m_time;
+    float end = duration == NEVER ? NEVER : m_time + duration;
+
+    while (!m_events.empty())
+    {
+        Event event = m_events.front();
+        if (event.Time > end)
+            break;
+
+        pop_heap(m_events.begin(), m_events.end(), greater<Event>());
+        m_events.pop_back();
+
+        if (event.SlotVersion != m_versions[event.Slot])
+            continue;
+        if (event.Type == EventType::BallBall && event.OtherVersion != m_versions[event.Other])
+            continue;
+
+        // evenimentul este pastrat pentru apelul urmator, iar timpul se opreste aici
+        if (m_processedEvents >= maxEvents)
+        {
+            m_events.push_back(event);
+            push_heap(m_events.begin(), m_events.end(), greater<Event>());
+            end = m_time;
+            break;
+        }
+
+        AdvanceAll(event.Time - m_time, world);
+        m_time = event.Time;
+        m_processedEvents++;
+
+        // doar o reverificare (avansul conservator nu a ajuns la contact): celelalte predictii ale bilelor raman valabile
+        if (event.Type == EventType::BallBall && !IsImpact(event.Slot, event.Other, world))
+        {
+            float time = PredictBallBall(event.Slot, event.Other, world);
+            if (time != NEVER)
+                PushEvent(time, EventType::BallBall, event.Slot, event.Other);
+            continue;
+        }
+
+        ProcessEvent(event, world, shotEvents);
+
+        m_versions[event.Slot]++;
+        if (event.Type == EventType::BallBall)
+            m_versions[event.Other]++;
+
+        Predict(event.Slot, 0, world, holes);
+        if (event.Type == EventType::BallBall)
+            Predict(event.Other, 0, world, holes);
+    }
+
+    if (end != NEVER)
+    {
+        AdvanceAll(end - m_time, world);
+        m_time = end;
+    }
+
+    float elapsed = m_time - start;
+
+    StoreBalls(world);
+
+    // cand toate bilele stau pe loc nu mai poate urma niciun eveniment, asa ca timpul cozii poate porni iar de la zero
+    bool moving = false;
+    for (int slot = 0; slot < world.GetCount() && !moving; slot++)
+        moving = world.OnBoard(slot) && world.GetVelocity(slot) != vec2(0.0f, 0.0f);
+
+    if (!moving)
+    {
+        m_events.clear();
+        m_time = 0.0f;
+    }
+
+    return elapsed;
+}
+
+// Aduce coada la zi cu schimbarile facute lumii intre apeluri. O bila schimbata primeste o versiune noua (deci
+// evenimentele ei vechi sunt ignorate) si este prezisa din nou fata de toate celelalte.
+void EventSolver::Synchronize(BallWorld& world, const vector<Hole*>& holes)
+{
+    bool rebuild = (int)m_handles.size() != world.GetCount();
+    for (int slot = 0; slot < world.GetCount() && !rebuild; slot++)
+        rebuild = m_handles[slot] != world.GetHandle(slot);
+
+    if (rebuild)
+    {
+        m_events.clear();
+        m_versions.assign(world.GetCount(), 0);
+        m_time = 0.0f;
+
+        StoreBalls(world);
+
+        // la inceput fiecare pereche este prezisa o singura data
+        for (int slot = 0; slot < world.GetCount(); slot++)
+            Predict(slot, slot + 1, world, holes);
+
+        return;
+    }
+
+    auto changed = [&](int slot)
+    {
+        return world.GetPosition(slot) != m_positions[slot] || world.GetVelocity(slot) != m_velocities[slot] || world.OnBoard(slot) != m_onBoard[slot];
+    };
+
+    for (int slot = 0; slot < world.GetCount(); slot++)
+        if (changed(slot))
+            m_versions[slot]++;
+
+    // versiunile sunt schimbate inainte de predictii, ca evenimentele dintre doua bile schimbate sa fie valabile
+    for (int slot = 0; slot < world.GetCount(); slot++)
+        if (changed(slot))
+            Predict(slot, 0, world, holes);
+
+    StoreBalls(world);
+}
+
+void EventSolver::StoreBalls(const BallWorld& world)
+{
+    m_handles.resize(world.GetCount());
+    m_positions.resize(world.GetCount());
+    m_velocities.resize(world.GetCount());
+    m_onBoard.resize(world.GetCount());
+
+    for (int slot = 0; slot < world.GetCount(); slot++)
+    {
+        m_handles[slot] = world.GetHandle(slot);
+        m_positions[slot] = world.GetPosition(slot);
+        m_velocities[slot] = world.GetVelocity(slot);
+        m_onBoard[slot] = world.OnBoard(slot);
+    }
+}
+
+void EventSolver::Predict(int slot, int firstOther, BallWorld& world, const vector<Hole*>& holes)
+{
+    if (!world.OnBoard(slot))
+        return;
+
+    for (int otherSlot = firstOther; otherSlot < world.GetCount(); otherSlot++)
+    {
+        if (otherSlot == slot || !world.OnBoard(otherSlot))
+            continue;
+
+        float time = PredictBallBall(slot, otherSlot, world);
+        if (time != NEVER)
+            PushEvent(time, EventType::BallBall, slot, otherSlot);
+    }
+
+    int cushion = -1;
+    float cushionTime = PredictCushion(slot, cushion, world);
+    if (cushionTime != NEVER)
+        PushEvent(cushionTime, EventType::Cushion, slot, cushion);
+
+    int hole = -1;
+    float holeTime = PredictHole(slot, hole, world, holes);
+    if (holeTime != NEVER)
+        PushEvent(holeTime, EventType::Hole, slot, hole);
+}
+
+// Avans conservator: distanta dintre bile nu poate scadea mai repede decat suma vitezelor lor,
+// asa ca timpul poate fi avansat cu gap / (v1 + v2) fara sa se sara peste impact. Daca nu se ajunge
+// la contact in MAX_ADVANCEMENT_STEPS pasi, evenimentul este doar o reverificare.
+float EventSolver::PredictBallBall(int slot, int otherSlot, BallWorld& world) const
+{
+    vec2 position = world.GetPosition(slot);
+    vec2 velocity = world.GetVelocity(slot);
+    vec2 otherPosition = world.GetPosition(otherSlot);
+    vec2 otherVelocity = world.GetVelocity(otherSlot);
+    float contactDistance = world.GetRadius(slot) + world.GetRadius(otherSlot);
+
+    float endTime = std::max(TimeToStop(velocity), TimeToStop(otherVelocity));
+
+    if (endTime <= 0.0f)
+        return NEVER;
+
+    float time = 0.0f;
+    for (int step = 0; step < MAX_ADVANCEMENT_STEPS; step++)
+    {
+        vec2 fromOther = PositionAfter(position, velocity, time) - PositionAfter(otherPosition, otherVelocity, time);
+        vec2 relativeVelocity = VelocityAfter(velocity, time) - VelocityAfter(otherVelocity, time);
+
+        float gap = length(fromOther) - contactDistance;
+        float closingBound = (length(VelocityAfter(velocity, time)) + length(VelocityAfter(otherVelocity, time))) * Ball::VELOCITY_MULTIPLIER;
+
+        if (closingBound <= 0.0f)
+            return NEVER;
+
+        if (gap <= CONTACT_EPSILON)
+        {
+            if (dot(relativeVelocity, fromOther) < 0.0f)
+                return m_time + time;
+
+            // se ating dar se departeaza; sarim cat le trebuie ca sa iasa din zona de contact
+            time += 2.0f * CONTACT_EPSILON / closingBound;
+        }
+        else
+        {
+            time += gap / closingBound;
+        }
+
+        if (time > endTime)
+            return NEVER;
+    }
+
+    return m_time + time;
+}
+
+float EventSolver::PredictCushion(int slot, int& cushion, BallWorld& world) const
+{
+    vec2 position = world.GetPosition(slot);
+    vec2 velocity = world.GetVelocity(slot);
+
+    float speed = length(velocity);
+    if (speed <= 0.0f)
+        return NEVER;
+
+    vec2 direction = velocity / speed;
+    float bestTime = NEVER;
+
+    float radius = world.GetRadius(slot);
+    float distances[4] = { NEVER, NEVER, NEVER, NEVER };
+
+    if (direction.x < 0.0f)
+        distances[LeftCushion] = (position.x - radius) / -direction.x;
+    if (direction.x > 0.0f)
+        distances[RightCushion] = (Constants::GAME_WIDTH - radius - position.x) / direction.x;
+    if (direction.y < 0.0f)
+        distances[BottomCushion] = (position.y - radius) / -direction.y;
+    if (direction.y > 0.0f)
+        distances[TopCushion] = (Constants::GAME_HEIGHT - radius - position.y) / direction.y;
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (distances[i] == NEVER)
+            continue;
+
+        float time = TimeToTravel(speed, distances[i]);
+        if (time < bestTime)
+        {
+            bestTime = time;
+            cushion = i;
+        }
+    }
+
+    return bestTime == NEVER ? NEVER : m_time + bestTime;
+}
+
+float EventSolver::PredictHole(int slot, int& hole, BallWorld& world, const vector<Hole*>& holes) const
+{
+    vec2 position = world.GetPosition(slot);
+    vec2 velocity = world.GetVelocity(slot);
+
+    float speed = length(velocity);
+    if (speed <= 0.0f)
+        return NEVER;
+
+    vec2 direction = velocity / speed;
+    float bestTime = NEVER;
+
+    for (int i = 0; i < (int)holes.size(); i++)
+    {
+        // |position + direction * s - hole|^2 = DISTANCE_TO_ENTER_HOLE^2, rezolvat pentru distanta s
+        vec2 fromHole = position - holes[i]->GetPosition();
+        float b = dot(direction, fromHole);
+        float c = dot(fromHole, fromHole) - Ball::DISTANCE_TO_ENTER_HOLE * Ball::DISTANCE_TO_ENTER_HOLE;
+        float discriminant = b * b - c;
+
+        if (discriminant < 0.0f)
+            continue;
+
+        float distance = -b - sqrt(discriminant);
+        if (distance < 0.0f && c > 0.0f)
+            continue;
+
+        float time = TimeToTravel(speed, distance);
+        if (time < bestTime)
+        {
+            bestTime = time;
+            hole = i;
+        }
+    }
+
+    return bestTime == NEVER ? NEVER : m_time + bestTime;
+}
+
+void EventSolver::ProcessEvent(const Event& event, BallWorld& world, ShotEvents& shotEvents)
+{
+    switch (event.Type)
+    {
+    case EventType::BallBall:
+        ResolveBallBall(event.Slot, event.Other, world, shotEvents);
+        break;
+    case EventType::Cushion:
+        ResolveCushion(event.Slot, event.Other, world, shotEvents);
+        break;
+    case EventType::Hole:
+        shotEvents.Record(world.GetHandle(event.Slot), world.GetPosition(event.Slot), ShotEvents::ContactType::Hole);
+
+        if (world.GetBallType(event.Slot) == Ball::BallType::White)
+        {
+            world.ResetWhite(event.Slot);
+            shotEvents.WhitePocketed = true;
+        }
+        else
+        {
+            world.SetVelocity(event.Slot, vec2(0.0f, 0.0f));
+            world.SetOnBoard(event.Slot, false);
+        }
+        world.SetStopped(event.Slot, true);
+        break;
+    }
+}
+
+// Bilele sunt in contact (cu toleranta evenimentelor) si nu se departeaza.
+bool EventSolver::IsImpact(int slot, int otherSlot, const BallWorld& world)
+{
+    vec2 fromOther = world.GetPosition(slot) - world.GetPosition(otherSlot);
+    float dist = length(fromOther);
+
+    if (dist - (world.GetRadius(slot) + world.GetRadius(otherSlot)) > 2.0f * CONTACT_EPSILON || dist <= 0.0f)
+        return false;
+
+    return dot(world.GetVelocity(slot) - world.GetVelocity(otherSlot), fromOther) <= 0.0f;
+}
+
+// Impulsul din BallPhysics, fara corectia de pozitie (bilele sunt exact in contact).
+// Apelat doar pentru un impact (vezi IsImpact).
+void EventSolver::ResolveBallBall(int slot, int otherSlot, BallWorld& world, ShotEvents& shotEvents)
+{
+    vec2 fromOther = world.GetPosition(slot) - world.GetPosition(otherSlot);
+    vec2 normal = fromOther / length(fromOther);
+
+    if (shotEvents.FirstWhiteContact == -1)
+    {
+        if (world.GetBallType(slot) == Ball::BallType::White)
+            shotEvents.FirstWhiteContact = world.GetHandle(otherSlot);
+        else if (world.GetBallType(otherSlot) == Ball::BallType::White)
+            shotEvents.FirstWhiteContact = world.GetHandle(slot);
+    }
+
+    shotEvents.Record(world.GetHandle(slot), world.GetPosition(slot), ShotEvents::ContactType::Ball);
+    shotEvents.Record(world.GetHandle(otherSlot), world.GetPosition(otherSlot), ShotEvents::ContactType::Ball);
+
+    BallPhysics<float>::State state = { world.GetPosition(slot), world.GetVelocity(slot), world.GetRadius(slot), false };
+    BallPhysics<float>::State other = { world.GetPosition(otherSlot), world.GetVelocity(otherSlot), world.GetRadius(otherSlot), false };
+    BallPhysics<float>::ApplyImpulse(state, other, normal);
+
+    world.SetVelocity(slot, state.Velocity);
+    world.SetVelocity(otherSlot, other.Velocity);
+    world.SetStopped(slot, false);
+    world.SetStopped(otherSlot, false);
+}
+
+void EventSolver::ResolveCushion(int slot, int cushion, BallWorld& world, ShotEvents& shotEvents)
+{
+    static const vec2 CUSHION_NORMALS[4] = { vec2(1.0f, 0.0f), vec2(-1.0f, 0.0f), vec2(0.0f, 1.0f), vec2(0.0f, -1.0f) };
+
+    vec2 normal = CUSHION_NORMALS[cushion];
+
+    BallPhysics<float>::State state = { world.GetPosition(slot), world.GetVelocity(slot), world.GetRadius(slot), false };
+    if (!BallPhysics<float>::ApplyImpulse(state, normal))
+        return;
+
+    shotEvents.Record(world.GetHandle(slot), world.GetPosition(slot), ShotEvents::ContactType::Cushion);
+
+    world.SetVelocity(slot, state.Velocity);
+}
+
+void EventSolver::AdvanceAll(float deltaTime, BallWorld& world)
+{
+    if (deltaTime <= 0.0f)
+        return;
+
+    for (int slot = 0; slot < world.GetCount(); slot++)
+    {
+        vec2 velocity = world.GetVelocity(slot);
+        if (!world.OnBoard(slot) || (velocity.x == 0.0f && velocity.y == 0.0f))
+            continue;
+
+        world.SetPosition(slot, PositionAfter(world.GetPosition(slot), velocity, deltaTime));
+
+        vec2 newVelocity = VelocityAfter(velocity, deltaTime);
+        world.SetVelocity(slot, newVelocity);
+        world.SetStopped(slot, newVelocity.x == 0.0f && newVelocity.y == 0.0f);
+    }
+}
+
+void EventSolver::PushEvent(float time, EventType type, int slot, int other)
+{
+    Event event;
+    event.Time         = time;
+    event.Type         = type;
+    event.Slot         = slot;
+    event.Other        = other;
+    event.SlotVersion  = m_versions[slot];
+    event.OtherVersion = type == EventType::BallBall ? m_versions[other] : 0;
+
+    m_events.push_back(event);
+    push_heap(m_events.begin(), m_events.end(), greater<Event>());
+}
+
+// Timpul dupa care o bila cu viteza speed parcurge distance, sau NEVER daca se opreste inainte.
+float EventSolver::TimeToTravel(float speed, float distance)
+{
+    if (distance <= 0.0f)
+        return 0.0f;
+
+    // distance = VELOCITY_MULTIPLIER * (speed * t - FRICTION_MULTIPLIER * t^2 / 2)
+    float discriminant = speed * speed - 2.0f * Ball::FRICTION_MULTIPLIER * distance / Ball::VELOCITY_MULTIPLIER;
+    if (discriminant < 0.0f)
+        return NEVER;
+
+    return (speed - sqrt(discriminant)) / Ball::FRICTION_MULTIPLIER;
+}
+
+float EventSolver::TimeToStop(vec2 velocity)
+{
+    return length(velocity) / Ball::FRICTION_MULTIPLIER;
+}
+
+vec2 EventSolver::PositionAfter(vec2 position, vec2 velocity, float time)
+{
+    float speed = length(velocity);
+    if (speed <= 0.0f)
+        return position;
+
+    time = std::min(time, speed / Ball::FRICTION_MULTIPLIER);
+    float distance = Ball::VELOCITY_MULTIPLIER * (speed * time - 0.5f * Ball::FRICTION_MULTIPLIER * time * time);
+
+    return position + (velocity / speed) * distance;
+}
+
+vec2 EventSolver::VelocityAfter(vec2 velocity, float time)
+{
+    float speed = length(velocity);
+    float newSpeed = speed - Ball::FRICTION_MULTIPLIER * time;
+
+    if (newSpeed <= 0.0f)
+        return vec2(0.0f, 0.0f);
+
+    return (velocity / speed) * newSpeed;
+}
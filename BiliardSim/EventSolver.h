@@ -0,0 +1,112 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+#include <vector>
+#include <functional>
+#include <glm/glm.hpp>
+
+#include "BallWorld.h"
+#include "Hole.h"
+#include "ShotEvents.h"
+
+// Rezolvitor bazat pe evenimente. Intre doua impacturi o bila merge in linie dreapta si incetineste
+// constant (FRICTION_MULTIPLIER), asa ca pozitia ei se poate calcula direct pentru orice moment.
+// Urmatoarele impacturi (bila-bila, bila-perete, bila-gaura) sunt prezise si tinute intr-o coada de
+// prioritate, iar timpul simularii sare direct de la un eveniment la urmatorul.
+// Coada ramane intre apeluri. La inceputul fiecarui apel bilele sunt comparate cu starea lasata de apelul anterior:
+// doar cele schimbate din afara (o lovitura, o stare restaurata) sunt prezise din nou; daca s-au schimbat sloturile,
+// coada este refacuta toata. Un apel proceseaza cel mult MAX_EVENTS_PER_UPDATE evenimente; timpul ramas este
+// simulat la apelurile urmatoare, ca un grup de bile lipite sa nu poata bloca un cadru oricat de mult.
+class EventSolver
+{
+private:
+
+    enum class EventType
+    {
+        BallBall,
+        Cushion,
+        Hole
+    };
+
+    enum Cushions
+    {
+        LeftCushion,
+        RightCushion,
+        BottomCushion,
+        TopCushion
+    };
+
+    struct Event
+    {
+    public:
+
+        bool operator>(const Event&) const;
+
+    public:
+
+        float     Time;
+        EventType Type;
+        int       Slot;
+        int       Other;
+        int       SlotVersion;
+        int       OtherVersion;
+    };
+
+private:
+
+    static const float CONTACT_EPSILON;
+    static const int   MAX_ADVANCEMENT_STEPS;
+    static const int   MAX_EVENTS_PER_UPDATE;
+    static const int   MAX_EVENTS_UNTIL_REST;
+
+public:
+
+    EventSolver();
+
+    void  Update(float, BallWorld&, const std::vector<Hole*>&, ShotEvents&);
+    float UpdateUntilRest(BallWorld&, const std::vector<Hole*>&, ShotEvents&);
+
+    int   GetProcessedEventCount() const;
+
+private:
+
+    float Simulate(float, int, BallWorld&, const std::vector<Hole*>&, ShotEvents&);
+    void  Synchronize(BallWorld&, const std::vector<Hole*>&);
+    void  StoreBalls(const BallWorld&);
+
+    void  Predict(int, int, BallWorld&, const std::vector<Hole*>&);
+    float PredictBallBall(int, int, BallWorld&) const;
+    float PredictCushion(int, int&, BallWorld&) const;
+    float PredictHole(int, int&, BallWorld&, const std::vector<Hole*>&) const;
+
+    void  ProcessEvent(const Event&, BallWorld&, ShotEvents&);
+    void  ResolveBallBall(int, int, BallWorld&, ShotEvents&);
+    void  ResolveCushion(int, int, BallWorld&, ShotEvents&);
+
+    void  AdvanceAll(float, BallWorld&);
+    void  PushEvent(float, EventType, int, int);
+
+    static bool      IsImpact(int, int, const BallWorld&);
+    static float     TimeToTravel(float, float);
+    static float     TimeToStop(glm::vec2);
+    static glm::vec2 PositionAfter(glm::vec2, glm::vec2, float);
+    static glm::vec2 VelocityAfter(glm::vec2, float);
+
+private:
+
+    // heap minim dupa Time (std::push_heap / std::pop_heap cu std::greater), ca memoria sa fie refolosita intre apeluri
+    std::vector<Event>     m_events;
+    std::vector<int>       m_versions;
+
+    // bilele asa cum le-a lasat ultimul apel, ca schimbarile facute intre apeluri sa poata fi gasite
+    std::vector<int>       m_handles;
+    std::vector<glm::vec2> m_positions;
+    std::vector<glm::vec2> m_velocities;
+    std::vector<bool>      m_onBoard;
+
+    // timpul cozii, de la ultima oprire a tuturor bilelor, si timpul ramas nesimulat din cauza limitei de evenimente
+    float                  m_time;
+    float                  m_backlog;
+    int                    m_processedEvents;
+};
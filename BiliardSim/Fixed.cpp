@@ -0,0 +1,220 @@
+#include "Fixed.h"
+
+#include <climits>
+#include <cmath>
+
+using namespace std;
+
+namespace
+{
+    const double ONE = 4294967296.0;
+
+    unsigned long long Magnitude(long long value)
+    {
+        return value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+    }
+
+    long long ApplySign(unsigned long long magnitude, bool negative)
+    {
+        return negative ? (long long)(0ULL - magnitude) : (long long)magnitude;
+    }
+
+    unsigned long long IntegerSqrt(unsigned long long value)
+    {
+        unsigned long long result = 0;
+        unsigned long long bit = 1ULL << 62;
+
+        while (bit > value)
+            bit >>= 2;
+
+        while (bit != 0)
+        {
+            if (value >= result + bit)
+            {
+                value -= result + bit;
+                result = (result >> 1) + bit;
+            }
+            else
+            {
+                result >>= 1;
+            }
+            bit >>= 2;
+        }
+
+        return result;
+    }
+}
+
+Fixed::Fixed() :
+    m_raw(0)
+{
+}
+
+Fixed::Fixed(int value) :
+    m_raw((long long)value * (1LL << FRACTION_BITS))
+{
+}
+
+// Inmultirea cu 2^32 este exacta, iar rotunjirea este la cel mai apropiat, deci conversia nu depinde de platforma.
+Fixed::Fixed(float value) :
+    m_raw(llround((double)value * ONE))
+{
+}
+
+Fixed::Fixed(double value) :
+    m_raw(llround(value * ONE))
+{
+}
+
+Fixed Fixed::FromRaw(long long raw)
+{
+    Fixed result;
+    result.m_raw = raw;
+    return result;
+}
+
+long long Fixed::GetRaw() const
+{
+    return m_raw;
+}
+
+float Fixed::ToFloat() const
+{
+    return (float)ToDouble();
+}
+
+double Fixed::ToDouble() const
+{
+    return (double)m_raw / ONE;
+}
+
+Fixed Fixed::operator-() const
+{
+    return FromRaw(ApplySign(Magnitude(m_raw), m_raw > 0));
+}
+
+Fixed& Fixed::operator+=(Fixed other)
+{
+    return *this = *this + other;
+}
+
+Fixed& Fixed::operator-=(Fixed other)
+{
+    return *this = *this - other;
+}
+
+Fixed& Fixed::operator*=(Fixed other)
+{
+    return *this = *this * other;
+}
+
+Fixed& Fixed::operator/=(Fixed other)
+{
+    return *this = *this / other;
+}
+
+Fixed operator+(Fixed a, Fixed b)
+{
+    return Fixed::FromRaw((long long)((unsigned long long)a.GetRaw() + (unsigned long long)b.GetRaw()));
+}
+
+Fixed operator-(Fixed a, Fixed b)
+{
+    return Fixed::FromRaw((long long)((unsigned long long)a.GetRaw() - (unsigned long long)b.GetRaw()));
+}
+
+// (aH * 2^32 + aL) * (bH * 2^32 + bL) / 2^32, fara tipuri de 128 de biti: bitii sub 2^-32 sunt taiati.
+Fixed operator*(Fixed a, Fixed b)
+{
+    bool negative = (a.GetRaw() < 0) != (b.GetRaw() < 0);
+
+    unsigned long long x = Magnitude(a.GetRaw());
+    unsigned long long y = Magnitude(b.GetRaw());
+
+    unsigned long long xHigh = x >> 32;
+    unsigned long long xLow  = x & 0xffffffffULL;
+    unsigned long long yHigh = y >> 32;
+    unsigned long long yLow  = y & 0xffffffffULL;
+
+    unsigned long long result = ((xHigh * yHigh) << 32) + xHigh * yLow + xLow * yHigh + ((xLow * yLow) >> 32);
+
+    return Fixed::FromRaw(ApplySign(result, negative));
+}
+
+// Partea intreaga vine dintr-o impartire obisnuita, iar cei 32 de biti de fractie dintr-o impartire bit cu bit a restului,
+// deci rezultatul este catul exact trunchiat. Un cat care nu incape in 32.32 (partea intreaga de cel putin 2^31) satureaza.
+Fixed operator/(Fixed a, Fixed b)
+{
+    bool negative = (a.GetRaw() < 0) != (b.GetRaw() < 0);
+
+    unsigned long long x = Magnitude(a.GetRaw());
+    unsigned long long y = Magnitude(b.GetRaw());
+
+    if (y == 0)
+        return Fixed::FromRaw(x == 0 ? 0 : (a.GetRaw() < 0 ? LLONG_MIN : LLONG_MAX));
+
+    unsigned long long quotient = x / y;
+    if (quotient >= 1ULL << 31)
+        return Fixed::FromRaw(negative ? LLONG_MIN : LLONG_MAX);
+
+    unsigned long long result = quotient << 32;
+    unsigned long long remainder = x % y;
+
+    for (int bit = 31; bit >= 0; bit--)
+    {
+        // restul este mai mic decat y <= 2^63, deci dublat incape inca in 64 de biti
+        remainder <<= 1;
+        if (remainder >= y)
+        {
+            remainder -= y;
+            result |= 1ULL << bit;
+        }
+    }
+
+    return Fixed::FromRaw(ApplySign(result, negative));
+}
+
+bool operator==(Fixed a, Fixed b)
+{
+    return a.GetRaw() == b.GetRaw();
+}
+
+bool operator!=(Fixed a, Fixed b)
+{
+    return a.GetRaw() != b.GetRaw();
+}
+
+bool operator<(Fixed a, Fixed b)
+{
+    return a.GetRaw() < b.GetRaw();
+}
+
+bool operator<=(Fixed a, Fixed b)
+{
+    return a.GetRaw() <= b.GetRaw();
+}
+
+bool operator>(Fixed a, Fixed b)
+{
+    return a.GetRaw() > b.GetRaw();
+}
+
+bool operator>=(Fixed a, Fixed b)
+{
+    return a.GetRaw() >= b.GetRaw();
+}
+
+// Radacina intreaga a valorii brute da doar 16 biti de fractie; doi pasi Newton o aduc la precizia completa.
+Fixed sqrt(Fixed value)
+{
+    if (value.GetRaw() <= 0)
+        return Fixed();
+
+    unsigned long long root = IntegerSqrt((unsigned long long)value.GetRaw());
+    Fixed result = Fixed::FromRaw((long long)(root << 16));
+
+    for (int step = 0; step < 2; step++)
+        result = Fixed::FromRaw((result + value / result).GetRaw() / 2);
+
+    return result;
+}
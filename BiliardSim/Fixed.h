@@ -0,0 +1,52 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+// Numar cu virgula fixa 32.32 tinut intr-un long long: 32 de biti pentru partea intreaga (cu semn) si 32 pentru fractie.
+// Toate operatiile sunt pe intregi, asa ca rezultatele sunt aceleasi pe orice platforma si cu orice compilator.
+// Inmultirea si impartirea trunchiaza spre zero; impartirea la zero si catul care nu incape in 32.32 satureaza.
+class Fixed
+{
+public:
+
+    static const int FRACTION_BITS = 32;
+
+public:
+
+    Fixed();
+    explicit Fixed(int);
+    explicit Fixed(float);
+    explicit Fixed(double);
+
+    static Fixed FromRaw(long long);
+
+    long long    GetRaw()   const;
+    float        ToFloat()  const;
+    double       ToDouble() const;
+
+    Fixed        operator-() const;
+
+    Fixed&       operator+=(Fixed);
+    Fixed&       operator-=(Fixed);
+    Fixed&       operator*=(Fixed);
+    Fixed&       operator/=(Fixed);
+
+private:
+
+    long long m_raw;
+};
+
+Fixed operator+(Fixed, Fixed);
+Fixed operator-(Fixed, Fixed);
+Fixed operator*(Fixed, Fixed);
+Fixed operator/(Fixed, Fixed);
+
+bool  operator==(Fixed, Fixed);
+bool  operator!=(Fixed, Fixed);
+bool  operator<(Fixed, Fixed);
+bool  operator<=(Fixed, Fixed);
+bool  operator>(Fixed, Fixed);
+bool  operator>=(Fixed, Fixed);
+
+// gasita prin ADL din codul sablon care scrie "using std::sqrt; sqrt(x)"
+Fixed sqrt(Fixed);
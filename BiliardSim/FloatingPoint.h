@@ -0,0 +1,13 @@
+#pragma once
+
+#include <limits>
+
+// Fizica trebuie sa dea aceleasi rezultate bit cu bit pe orice compilator si la orice nivel de optimizare,
+// asa ca a * b + c nu are voie sa fie contractat intr-un FMA (care rotunjeste o singura data).
+// Asta se cere din configuratia de build: /fp:precise in proiectele Visual Studio, -ffp-contract=off pentru
+// GCC si Clang. Aici se verifica doar ce se poate vedea din cod.
+#if defined(_M_FP_FAST) || defined(__FAST_MATH__)
+#error "BiliardSim nu poate fi compilat cu /fp:fast sau -ffast-math: simularea nu ar mai fi determinista"
+#endif
+
+static_assert(std::numeric_limits<float>::is_iec559, "BiliardSim are nevoie de float IEEE 754");
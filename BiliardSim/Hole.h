@@ -1,5 +1,7 @@
 #pragma once
 
+#include "FloatingPoint.h"
+
 #include <glm/glm.hpp>
 
 class Hole
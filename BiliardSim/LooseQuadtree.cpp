@@ -0,0 +1,243 @@
+#include "LooseQuadtree.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+using namespace glm;
+
+LooseQuadtree::LooseQuadtree(float width, float height, int depth) :
+    m_rootSize(std::max(width, height))
+{
+    int cellCount = 0;
+
+    for (int levelIndex = 0; levelIndex <= depth; levelIndex++)
+    {
+        Level level;
+        level.CellSize  = m_rootSize / (float)(1 << levelIndex);
+        level.Columns   = std::max(1, (int)ceil(width / level.CellSize));
+        level.Rows      = std::max(1, (int)ceil(height / level.CellSize));
+        level.FirstCell = cellCount;
+        level.BallCount = 0;
+
+        m_levels.push_back(level);
+        cellCount += level.Columns * level.Rows;
+    }
+
+    m_firstInCell.assign(cellCount, -1);
+}
+
+void LooseQuadtree::Update(const BallWorld& world)
+{
+    if ((int)m_cellOfHandle.size() < world.GetHandleCount())
+    {
+        int handleCount = world.GetHandleCount();
+
+        m_cellOfHandle.resize(handleCount, -1);
+        m_levelOfHandle.resize(handleCount, -1);
+        m_next.resize(handleCount, -1);
+        m_previous.resize(handleCount, -1);
+        m_positionX.resize(handleCount, 0.0f);
+        m_positionY.resize(handleCount, 0.0f);
+        m_radius.resize(handleCount, 0.0f);
+    }
+
+    const float* positionX = world.GetPositionsX();
+    const float* positionY = world.GetPositionsY();
+    const float* radius = world.GetRadii();
+
+    // Doar bilele care au trecut in alta celula (sau si-au schimbat nivelul) sunt mutate.
+    for (int slot = 0; slot < world.GetCount(); slot++)
+    {
+        int handle = world.GetHandle(slot);
+
+        m_positionX[handle] = positionX[slot];
+        m_positionY[handle] = positionY[slot];
+        m_radius[handle] = radius[slot];
+
+        int level = GetLevel(radius[slot]);
+        int cell = GetCell(level, vec2(positionX[slot], positionY[slot]));
+        if (cell == m_cellOfHandle[handle])
+            continue;
+
+        if (m_cellOfHandle[handle] != -1)
+            Unlink(handle);
+
+        Insert(handle, level, cell);
+    }
+}
+
+void LooseQuadtree::Remove(int handle)
+{
+    if (handle >= (int)m_cellOfHandle.size() || m_cellOfHandle[handle] == -1)
+        return;
+
+    Unlink(handle);
+}
+
+// Fiecare bila cauta doar pe nivelul ei si pe cele mai mari. Pe nivelul ei pastreaza doar bilele cu handle mai mare,
+// asa ca fiecare pereche apare o singura data. Perechile ale caror dreptunghiuri nu se ating sunt sarite.
+void LooseQuadtree::FindPairs(vector<pair<int, int>>& pairs) const
+{
+    pairs.clear();
+
+    for (int handle = 0; handle < (int)m_cellOfHandle.size(); handle++)
+    {
+        if (m_cellOfHandle[handle] == -1)
+            continue;
+
+        float x = m_positionX[handle];
+        float y = m_positionY[handle];
+        float r = m_radius[handle];
+
+        vec2 min = vec2(x - r, y - r);
+        vec2 max = vec2(x + r, y + r);
+
+        for (int levelIndex = 0; levelIndex <= m_levelOfHandle[handle]; levelIndex++)
+        {
+            const Level& level = m_levels[levelIndex];
+            if (level.BallCount == 0)
+                continue;
+
+            bool sameLevel = levelIndex == m_levelOfHandle[handle];
+
+            int minX, minY, maxX, maxY;
+            GetRange(levelIndex, min, max, minX, minY, maxX, maxY);
+
+            for (int cellY = minY; cellY <= maxY; cellY++)
+            {
+                for (int cellX = minX; cellX <= maxX; cellX++)
+                {
+                    int cell = level.FirstCell + cellY * level.Columns + cellX;
+
+                    for (int other = m_firstInCell[cell]; other != -1; other = m_next[other])
+                    {
+                        if (sameLevel && other <= handle)
+                            continue;
+
+                        float reach = r + m_radius[other];
+                        if (abs(m_positionX[other] - x) > reach || abs(m_positionY[other] - y) > reach)
+                            continue;
+
+                        pairs.push_back(make_pair(handle, other));
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Handle-urile bilelor al caror dreptunghi atinge dreptunghiul [min, max], dupa pozitiile de la ultimul Update.
+void LooseQuadtree::FindInBox(vec2 min, vec2 max, vector<int>& handles) const
+{
+    handles.clear();
+
+    for (int levelIndex = 0; levelIndex < (int)m_levels.size(); levelIndex++)
+    {
+        const Level& level = m_levels[levelIndex];
+        if (level.BallCount == 0)
+            continue;
+
+        int minX, minY, maxX, maxY;
+        GetRange(levelIndex, min, max, minX, minY, maxX, maxY);
+
+        for (int cellY = minY; cellY <= maxY; cellY++)
+        {
+            for (int cellX = minX; cellX <= maxX; cellX++)
+            {
+                int cell = level.FirstCell + cellY * level.Columns + cellX;
+
+                for (int other = m_firstInCell[cell]; other != -1; other = m_next[other])
+                {
+                    float r = m_radius[other];
+                    if (m_positionX[other] + r < min.x || m_positionX[other] - r > max.x ||
+                        m_positionY[other] + r < min.y || m_positionY[other] - r > max.y)
+                        continue;
+
+                    handles.push_back(other);
+                }
+            }
+        }
+    }
+}
+
+// Cel mai adanc nivel la care o celula este cel putin cat diametrul bilei.
+int LooseQuadtree::GetLevel(float radius) const
+{
+    int level = 0;
+    while (level + 1 < (int)m_levels.size() && m_levels[level + 1].CellSize >= 2.0f * radius)
+        level++;
+
+    return level;
+}
+
+// Indexul celulei care contine coordonata, limitat la [0, count); o coordonata NaN ajunge in prima celula.
+int LooseQuadtree::GetCoordinate(float value, float cellSize, int count) const
+{
+    float cell = floor(value / cellSize);
+
+    if (!(cell >= 0.0f))
+        return 0;
+
+    if (cell >= (float)(count - 1))
+        return count - 1;
+
+    return (int)cell;
+}
+
+int LooseQuadtree::GetCell(int levelIndex, vec2 position) const
+{
+    const Level& level = m_levels[levelIndex];
+
+    int x = GetCoordinate(position.x, level.CellSize, level.Columns);
+    int y = GetCoordinate(position.y, level.CellSize, level.Rows);
+
+    return level.FirstCell + y * level.Columns + x;
+}
+
+// Celulele de pe un nivel ale caror limite largi ating dreptunghiul [min, max].
+void LooseQuadtree::GetRange(int levelIndex, vec2 min, vec2 max, int& minX, int& minY, int& maxX, int& maxY) const
+{
+    const Level& level = m_levels[levelIndex];
+    float margin = level.CellSize * 0.5f;
+
+    minX = GetCoordinate(min.x - margin, level.CellSize, level.Columns);
+    minY = GetCoordinate(min.y - margin, level.CellSize, level.Rows);
+    maxX = GetCoordinate(max.x + margin, level.CellSize, level.Columns);
+    maxY = GetCoordinate(max.y + margin, level.CellSize, level.Rows);
+}
+
+void LooseQuadtree::Insert(int handle, int level, int cell)
+{
+    m_cellOfHandle[handle] = cell;
+    m_levelOfHandle[handle] = level;
+    m_levels[level].BallCount++;
+
+    m_previous[handle] = -1;
+    m_next[handle] = m_firstInCell[cell];
+
+    if (m_firstInCell[cell] != -1)
+        m_previous[m_firstInCell[cell]] = handle;
+
+    m_firstInCell[cell] = handle;
+}
+
+void LooseQuadtree::Unlink(int handle)
+{
+    int cell = m_cellOfHandle[handle];
+
+    if (m_previous[handle] != -1)
+        m_next[m_previous[handle]] = m_next[handle];
+    else
+        m_firstInCell[cell] = m_next[handle];
+
+    if (m_next[handle] != -1)
+        m_previous[m_next[handle]] = m_previous[handle];
+
+    m_levels[m_levelOfHandle[handle]].BallCount--;
+
+    m_cellOfHandle[handle] = -1;
+    m_levelOfHandle[handle] = -1;
+    m_next[handle] = -1;
+    m_previous[handle] = -1;
+}
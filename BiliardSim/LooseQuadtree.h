@@ -0,0 +1,71 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+#include <vector>
+#include <utility>
+#include <glm/glm.hpp>
+
+#include "BallWorld.h"
+
+// Broadphase pentru coliziunile dintre bile de raze diferite. Nivelul L imparte masa in celule patrate de latura
+// (latura mesei) / 2^L, iar fiecare bila sta pe cel mai adanc nivel la care celula este cel putin cat diametrul ei,
+// in celula care ii contine centrul. Celulele sunt "largi": limitele lor sunt marite cu o jumatate de celula pe fiecare
+// parte, asa ca bila este mereu cuprinsa in celula ei si este mutata doar cand centrul trece in alta celula.
+// Celulele sunt liste inlantuite de handle-uri, deci Update nu aloca memorie dupa ce a vazut toate bilele.
+// O cautare viziteaza cateva celule pe fiecare nivel ocupat, asa ca costul ramane aproape O(n log n) si pentru
+// multe bile de marimi amestecate. Bilele din afara mesei sunt puse in celulele de pe margine.
+class LooseQuadtree
+{
+public:
+
+    static const int DEFAULT_DEPTH = 8;
+
+public:
+
+    LooseQuadtree(float, float, int = DEFAULT_DEPTH);
+
+    void Update(const BallWorld&);
+    void Remove(int);
+
+    void FindPairs(std::vector<std::pair<int, int>>&) const;
+    void FindInBox(glm::vec2, glm::vec2, std::vector<int>&) const;
+
+private:
+
+    struct Level
+    {
+        float CellSize;
+        int   Columns;
+        int   Rows;
+        int   FirstCell;
+        int   BallCount;
+    };
+
+private:
+
+    int  GetLevel(float) const;
+    int  GetCoordinate(float, float, int) const;
+    int  GetCell(int, glm::vec2) const;
+    void GetRange(int, glm::vec2, glm::vec2, int&, int&, int&, int&) const;
+
+    void Insert(int, int, int);
+    void Unlink(int);
+
+private:
+
+    float              m_rootSize;
+    std::vector<Level> m_levels;
+
+    // primul handle din fiecare celula, pentru toate nivelurile la rand; -1 daca celula este goala
+    std::vector<int>   m_firstInCell;
+
+    // pentru fiecare handle: unde sta, vecinii din lista celulei si pozitia / raza de la ultimul Update
+    std::vector<int>   m_cellOfHandle;
+    std::vector<int>   m_levelOfHandle;
+    std::vector<int>   m_next;
+    std::vector<int>   m_previous;
+    std::vector<float> m_positionX;
+    std::vector<float> m_positionY;
+    std::vector<float> m_radius;
+};
@@ -0,0 +1,700 @@
+#include "Physics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "BallPhysics.h"
+#include "Constants.h"
+#include "ThreadPool.h"
+
+using namespace std;
+using namespace glm;
+
+const float Physics::DETERMINISTIC_STEP        = 1.0f / 120.0f;
+const float Physics::DEFAULT_SUBSTEP_FRACTION  = 1.0f;
+const float Physics::CCD_DISPLACEMENT_FRACTION = 0.5f;
+
+Physics::StepStatistics::StepStatistics() :
+    Steps(0),
+    Substeps(0),
+    MaxSubsteps(0),
+    LastSubsteps(0)
+{
+}
+
+Physics::Physics() :
+    m_quadtree(Constants::GAME_WIDTH, Constants::GAME_HEIGHT),
+    m_threadPool(nullptr),
+    m_instructionSet(BallKernels::GetBestInstructionSet()),
+    m_solver(Solver::TimeStepped),
+    m_contactIterations(ContactSolver::DEFAULT_ITERATIONS),
+    m_substepFraction(DEFAULT_SUBSTEP_FRACTION),
+    m_deterministic(false),
+    m_accumulator(0.0f)
+{
+}
+
+void Physics::Update(float deltaTime, BallWorld& world, const vector<Hole*>& holes)
+{
+    if (!m_deterministic)
+    {
+        Step(deltaTime, world, holes);
+        return;
+    }
+
+    // timpul primit este adunat si simulat doar in pasi intregi, ca rezultatul sa nu depinda de durata cadrelor
+    m_accumulator += deltaTime;
+    while (m_accumulator >= DETERMINISTIC_STEP)
+    {
+        Step(DETERMINISTIC_STEP, world, holes);
+        m_accumulator -= DETERMINISTIC_STEP;
+    }
+}
+
+void Physics::Step(float deltaTime, BallWorld& world, const vector<Hole*>& holes)
+{
+    if (m_solver == Solver::EventDriven)
+    {
+        m_eventSolver.Update(deltaTime, world, holes, m_shotEvents);
+        SleepStoppedBalls(world);
+        return;
+    }
+
+    m_stepStatistics.Steps++;
+    m_stepStatistics.LastSubsteps = 0;
+
+    if (world.GetAwakeCount() == 0)
+        return;
+
+    int substeps = GetSubstepCount(deltaTime, world);
+    float substep = deltaTime / substeps;
+
+    for (int index = 0; index < substeps; index++)
+    {
+        // bilele se pot opri la jumatatea pasului; subpasii ramasi nu mai au ce face
+        if (world.GetAwakeCount() == 0)
+            break;
+
+        Substep(substep, deltaTime, world, holes);
+        m_stepStatistics.LastSubsteps++;
+    }
+
+    m_stepStatistics.Substeps += m_stepStatistics.LastSubsteps;
+    m_stepStatistics.MaxSubsteps = glm::max(m_stepStatistics.MaxSubsteps, m_stepStatistics.LastSubsteps);
+}
+
+void Physics::Substep(float deltaTime, float stepTime, BallWorld& world, const vector<Hole*>& holes)
+{
+    m_quadtree.Update(world);
+    WakeTouchedBalls(deltaTime, world);
+    m_quadtree.FindPairs(m_colissionPairs);
+
+    // ordinea din arbore depinde de istoria ei (de exemplu dupa copierea dintr-o alta masa), nu doar de pozitii
+    if (m_deterministic)
+    {
+        for (auto& colissionPair : m_colissionPairs)
+            if (colissionPair.first > colissionPair.second)
+                swap(colissionPair.first, colissionPair.second);
+
+        sort(m_colissionPairs.begin(), m_colissionPairs.end());
+    }
+
+    if (m_solver == Solver::SequentialImpulse)
+        m_contactSolver.SolveIterative(m_colissionPairs, world, m_threadPool, m_contactIterations);
+    else
+        m_contactSolver.Solve(m_colissionPairs, world, m_threadPool);
+
+    // evenimentele loviturii sunt notate dupa rezolvare, in ordinea perechilor, nu in ordinea loturilor
+    for (auto& contact : m_contactSolver.GetContacts())
+    {
+        if (!contact.Touching)
+            continue;
+
+        RecordContact(world, contact.Slot, contact.OtherSlot);
+
+        if (!contact.Approaching)
+            continue;
+
+        m_shotEvents.Record(world.GetHandle(contact.Slot), contact.Position, ShotEvents::ContactType::Ball);
+        m_shotEvents.Record(world.GetHandle(contact.OtherSlot), contact.OtherPosition, ShotEvents::ContactType::Ball);
+    }
+
+    ResolveWallColissions(world);
+    SweepFastBalls(deltaTime, stepTime, world, holes);
+    UpdateFriction(deltaTime, world);
+    ResolveHoles(world, holes);
+    SleepStoppedBalls(world);
+
+    // impulsurile pastrate nu mai au sens pentru urmatoarea lovitura
+    if (world.GetAwakeCount() == 0)
+        m_contactSolver.Reset();
+}
+
+// Cati subpasi trebuie ca cea mai rapida bila (fata de raza ei) sa treaca intr-unul cel mult m_substepFraction din raza.
+int Physics::GetSubstepCount(float deltaTime, const BallWorld& world) const
+{
+    if (m_substepFraction <= 0.0f)
+        return 1;
+
+    const float travel = deltaTime * Ball::VELOCITY_MULTIPLIER;
+
+    float peak = 0.0f;
+    for (int slot = 0; slot < world.GetCount(); slot++)
+    {
+        if (world.IsAsleep(slot))
+            continue;
+
+        peak = glm::max(peak, length(world.GetVelocity(slot)) * travel / world.GetRadius(slot));
+    }
+
+    int substeps = (int)ceil(peak / m_substepFraction);
+    return glm::clamp(substeps, 1, (int)MAX_SUBSTEPS);
+}
+
+// Simuleaza pana cand toate bilele stau pe loc si intoarce timpul simulat.
+// Pasul este folosit doar de TimeStepped si SequentialImpulse, in ambele moduri; EventSolver nu are nevoie de el.
+// Un pas nul sau negativ inseamna DETERMINISTIC_STEP.
+float Physics::UpdateUntilRest(float deltaTime, BallWorld& world, const vector<Hole*>& holes)
+{
+    if (deltaTime <= 0.0f)
+        deltaTime = DETERMINISTIC_STEP;
+
+    if (m_solver == Solver::EventDriven)
+    {
+        float time = m_eventSolver.UpdateUntilRest(world, holes, m_shotEvents);
+        SleepStoppedBalls(world);
+        return time;
+    }
+
+    float time = 0.0f;
+    for (int step = 0; step < MAX_STEPS_UNTIL_REST; step++)
+    {
+        if (world.GetAwakeCount() == 0)
+            break;
+
+        Step(deltaTime, world, holes);
+        time += deltaTime;
+    }
+
+    return time;
+}
+
+// Scoate din arbore si din lume toate bilele care nu mai sunt pe masa, dupa flag-ul fiecarui slot.
+void Physics::RemovePocketed(BallWorld& world)
+{
+    if (world.GetPocketedCount() == 0)
+        return;
+
+    for (int slot = 0; slot < world.GetCount(); slot++)
+        if (!world.OnBoard(slot))
+            m_quadtree.Remove(world.GetHandle(slot));
+
+    world.RemovePocketed();
+}
+
+void Physics::SaveState(TableState& state) const
+{
+    state.PhysicsAccumulator = m_accumulator;
+    state.FirstWhiteContact = m_shotEvents.FirstWhiteContact;
+    state.WhitePocketed = m_shotEvents.WhitePocketed;
+
+    m_contactSolver.SaveState(state);
+}
+
+// Lumea trebuie sa fie deja adusa in starea salvata. Bilele care nu mai sunt pe masa sunt scoase din arbore,
+// iar restul sunt mutate in celulele lor la urmatorul Update; contactele inregistrate sunt sterse, iar impulsurile
+// pastrate de SequentialImpulse sunt cele salvate.
+void Physics::RestoreState(const TableState& state, const BallWorld& world)
+{
+    m_accumulator = state.PhysicsAccumulator;
+
+    m_shotEvents.Reset();
+    m_shotEvents.FirstWhiteContact = state.FirstWhiteContact;
+    m_shotEvents.WhitePocketed = state.WhitePocketed;
+
+    m_contactSolver.RestoreState(state);
+
+    for (int handle = 0; handle < world.GetHandleCount(); handle++)
+        if (world.GetSlot(handle) == -1)
+            m_quadtree.Remove(handle);
+}
+
+void Physics::ResetStepStatistics()
+{
+    m_stepStatistics = StepStatistics();
+}
+
+const Physics::StepStatistics& Physics::GetStepStatistics() const
+{
+    return m_stepStatistics;
+}
+
+// Cat poate trece o bila intr-un subpas, ca fractiune din raza ei; 0 opreste impartirea pasului.
+// Peste MAX_SUBSTEPS subpasi bilele rapide raman in grija CCD-ului.
+void Physics::SetSubstepFraction(float fraction)
+{
+    m_substepFraction = glm::max(fraction, 0.0f);
+}
+
+float Physics::GetSubstepFraction() const
+{
+    return m_substepFraction;
+}
+
+void Physics::SetSolver(Solver solver)
+{
+    m_solver = solver;
+}
+
+Physics::Solver Physics::GetSolver() const
+{
+    return m_solver;
+}
+
+// Numarul de treceri prin contacte pentru SequentialImpulse; mai multe treceri aseaza mai bine grupurile mari de bile.
+void Physics::SetContactIterations(int iterations)
+{
+    m_contactIterations = glm::max(iterations, 1);
+}
+
+int Physics::GetContactIterations() const
+{
+    return m_contactIterations;
+}
+
+void Physics::SetDeterministic(bool deterministic)
+{
+    m_deterministic = deterministic;
+    m_accumulator = 0.0f;
+}
+
+bool Physics::IsDeterministic() const
+{
+    return m_deterministic;
+}
+
+void Physics::ResetShotEvents()
+{
+    m_shotEvents.Reset();
+}
+
+const ShotEvents& Physics::GetShotEvents() const
+{
+    return m_shotEvents;
+}
+
+void Physics::SetContactRecording(bool record)
+{
+    m_shotEvents.RecordContacts = record;
+}
+
+// Pool-ul nu este detinut de Physics; nullptr inseamna ca tot pasul (contactele si CCD-ul) merge pe thread-ul apelant.
+// Rezultatul nu depinde de pool, doar timpul.
+void Physics::SetThreadPool(ThreadPool* threadPool)
+{
+    m_threadPool = threadPool;
+}
+
+ThreadPool* Physics::GetThreadPool() const
+{
+    return m_threadPool;
+}
+
+void Physics::SetInstructionSet(BallKernels::InstructionSet instructionSet)
+{
+    m_instructionSet = instructionSet;
+}
+
+BallKernels::InstructionSet Physics::GetInstructionSet() const
+{
+    return m_instructionSet;
+}
+
+// Trezeste bilele adormite pe langa care trece o bila in miscare in pasul curent: dreptunghiul acoperit de bila
+// intre pozitia de acum si cea de dupa pas, marit cu raza bilei; orice bila care atinge dreptunghiul poate fi lovita.
+void Physics::WakeTouchedBalls(float deltaTime, BallWorld& world)
+{
+    for (int slot = 0; slot < world.GetCount(); slot++)
+    {
+        if (world.IsAsleep(slot))
+            continue;
+
+        vec2 velocity = world.GetVelocity(slot);
+        if (velocity.x == 0.0f && velocity.y == 0.0f)
+            continue;
+
+        vec2 position = world.GetPosition(slot);
+        vec2 nextPosition = position + velocity * deltaTime * Ball::VELOCITY_MULTIPLIER;
+
+        vec2 reach = vec2(world.GetRadius(slot));
+        vec2 boundsMin = glm::min(position, nextPosition) - reach;
+        vec2 boundsMax = glm::max(position, nextPosition) + reach;
+
+        m_quadtree.FindInBox(boundsMin, boundsMax, m_nearbyHandles);
+
+        for (auto& handle : m_nearbyHandles)
+        {
+            int otherSlot = world.GetSlot(handle);
+            if (world.IsAsleep(otherSlot))
+                world.Wake(otherSlot);
+        }
+    }
+}
+
+void Physics::SleepStoppedBalls(BallWorld& world)
+{
+    for (int slot = 0; slot < world.GetCount(); slot++)
+    {
+        if (!world.IsAsleep(slot) && world.IsStopped(slot))
+            world.Sleep(slot);
+    }
+}
+
+void Physics::RecordContact(BallWorld& world, int slot, int otherSlot)
+{
+    if (m_shotEvents.FirstWhiteContact != -1)
+        return;
+
+    if (world.GetBallType(slot) == Ball::BallType::White)
+        m_shotEvents.FirstWhiteContact = world.GetHandle(otherSlot);
+    else if (world.GetBallType(otherSlot) == Ball::BallType::White)
+        m_shotEvents.FirstWhiteContact = world.GetHandle(slot);
+}
+
+void Physics::ResolveCushion(BallWorld& world, int slot, vec2 normal, float penetration)
+{
+    BallPhysics<float>::State state = { world.GetPosition(slot), world.GetVelocity(slot), world.GetRadius(slot), false };
+
+    bool approaching = BallPhysics<float>::ResolveCushion(state, normal, penetration);
+
+    world.SetPosition(slot, state.Position);
+
+    if (!approaching)
+        return;
+
+    m_shotEvents.Record(world.GetHandle(slot), state.Position, ShotEvents::ContactType::Cushion);
+
+    world.SetVelocity(slot, state.Velocity);
+}
+
+// Adancimea este masurata de-a lungul normalei peretelui, asa ca o bila care a trecut de perete este adusa inapoi pe masa.
+void Physics::ResolveWallColissions(BallWorld& world)
+{
+    const float* positionX = world.GetPositionsX();
+    const float* positionY = world.GetPositionsY();
+    const float* radius = world.GetRadii();
+
+    for (int slot = 0; slot < world.GetCount(); slot++)
+    {
+        if (world.IsAsleep(slot))
+            continue;
+
+        if (positionX[slot] - radius[slot] <= 0.0f)
+            ResolveCushion(world, slot, vec2(1.0f, 0.0f), radius[slot] - positionX[slot]);
+
+        if (positionX[slot] + radius[slot] >= Constants::GAME_WIDTH)
+            ResolveCushion(world, slot, vec2(-1.0f, 0.0f), positionX[slot] + radius[slot] - Constants::GAME_WIDTH);
+
+        if (positionY[slot] - radius[slot] <= 0.0f)
+            ResolveCushion(world, slot, vec2(0.0f, 1.0f), radius[slot] - positionY[slot]);
+
+        if (positionY[slot] + radius[slot] >= Constants::GAME_HEIGHT)
+            ResolveCushion(world, slot, vec2(0.0f, -1.0f), positionY[slot] + radius[slot] - Constants::GAME_HEIGHT);
+    }
+}
+
+// CCD pentru bilele rapide, inainte de deplasarea din UpdateFriction. In subpas, bila merge de la pozitie la
+// pozitie + viteza * travel; o bila este rapida dupa cat ar merge in tot pasul (stepTime), nu doar in subpas. La prima trecere, fiecare bila rapida isi cauta primul impact (in paralel, daca exista pool);
+// impacturile sunt apoi rezolvate in ordinea momentului, sarind peste cele cu o bila deja lovita in trecerea curenta.
+// La trecerile urmatoare sunt cautate din nou doar bilele lovite si cele sarite, restul nu si-au schimbat drumul. Dupa un impact la momentul t, pozitia bilei este mutata inapoi
+// cu viteza noua * travel * t, asa ca deplasarea normala de la sfarsitul pasului o duce exact pe drumul de dupa impact.
+void Physics::SweepFastBalls(float deltaTime, float stepTime, BallWorld& world, const vector<Hole*>& holes)
+{
+    const float travel = deltaTime * Ball::VELOCITY_MULTIPLIER;
+    const float stepTravel = stepTime * Ball::VELOCITY_MULTIPLIER;
+
+    for (int pass = 0; pass < MAX_SWEEP_PASSES; pass++)
+    {
+        // Arborele are pozitiile de la inceputul pasului, iar o bila se departeaza de a ei cel mult cu cat merge intr-un pas.
+        float maxDisplacement = 0.0f;
+        bool fastBalls = false;
+
+        for (int slot = 0; slot < world.GetCount(); slot++)
+        {
+            if (world.IsAsleep(slot))
+                continue;
+
+            float speed = length(world.GetVelocity(slot));
+            maxDisplacement = glm::max(maxDisplacement, speed * travel);
+            fastBalls = fastBalls || speed * stepTravel > CCD_DISPLACEMENT_FRACTION * world.GetRadius(slot);
+        }
+
+        if (!fastBalls)
+            return;
+
+        if (pass == 0)
+        {
+            m_sweepTime.assign(world.GetCount(), 0.0f);
+            m_sweepPass.assign(world.GetCount(), -1);
+            m_sweepNext.assign(world.GetCount(), 0);
+            m_sweepHits.resize(world.GetCount());
+        }
+
+        int workerCount = m_threadPool ? m_threadPool->GetWorkerCount() : 1;
+        if ((int)m_workerHandles.size() < workerCount)
+            m_workerHandles.resize(workerCount);
+
+        float reach = maxDisplacement;
+
+        // fiecare bila scrie doar in m_sweepHits[slot], asa ca rezultatul nu depinde de impartirea pe thread-uri
+        auto sweep = [&](int slot, int worker)
+        {
+            m_sweepHits[slot].Time = 1.0f;
+
+            if (m_sweepNext[slot] != pass || world.IsAsleep(slot) || length(world.GetVelocity(slot)) * stepTravel <= CCD_DISPLACEMENT_FRACTION * world.GetRadius(slot))
+                return;
+
+            SweepBall(slot, travel, reach, world, holes, m_workerHandles[worker], m_sweepHits[slot]);
+        };
+
+        if (m_threadPool && world.GetCount() >= 2 * SWEEP_GRAIN)
+        {
+            m_threadPool->ParallelFor(world.GetCount(), SWEEP_GRAIN, sweep);
+        }
+        else
+        {
+            for (int slot = 0; slot < world.GetCount(); slot++)
+                sweep(slot, 0);
+        }
+
+        // impacturile gasite sunt mutate la inceputul vectorului si sortate dupa moment, apoi dupa slot
+        int hitCount = 0;
+        for (int slot = 0; slot < world.GetCount(); slot++)
+        {
+            if (m_sweepHits[slot].Time < 1.0f)
+                m_sweepHits[hitCount++] = m_sweepHits[slot];
+        }
+
+        if (hitCount == 0)
+            return;
+
+        sort(m_sweepHits.begin(), m_sweepHits.begin() + hitCount, [](const SweepHit& first, const SweepHit& second)
+        {
+            return first.Time < second.Time || (first.Time == second.Time && first.Slot < second.Slot);
+        });
+
+        for (int index = 0; index < hitCount; index++)
+        {
+            const SweepHit& hit = m_sweepHits[index];
+
+            if (m_sweepPass[hit.Slot] == pass || (hit.Other != -1 && m_sweepPass[hit.Other] == pass))
+            {
+                m_sweepNext[hit.Slot] = pass + 1;
+                continue;
+            }
+
+            m_sweepPass[hit.Slot] = pass;
+            m_sweepNext[hit.Slot] = pass + 1;
+            if (hit.Other != -1)
+            {
+                m_sweepPass[hit.Other] = pass;
+                m_sweepNext[hit.Other] = pass + 1;
+            }
+
+            ResolveSweepHit(hit, travel, world);
+        }
+    }
+}
+
+// Primul impact al bilei dupa m_sweepTime[slot] si inainte de sfarsitul pasului; Time ramane 1 daca nu atinge nimic.
+// Normal este unitar si arata spre bila din slot.
+void Physics::SweepBall(int slot, float travel, float reach, const BallWorld& world, const vector<Hole*>& holes, vector<int>& nearbyHandles, SweepHit& hit) const
+{
+    float startTime = m_sweepTime[slot];
+    vec2 origin = world.GetPosition(slot);
+    vec2 motion = world.GetVelocity(slot) * travel;
+    float radius = world.GetRadius(slot);
+
+    hit.Time = 1.0f;
+    hit.Slot = slot;
+    hit.Other = -1;
+    hit.Hole = -1;
+    hit.Normal = vec2(0.0f, 0.0f);
+
+    // peretii: momentul in care marginea bilei ajunge pe linia peretelui
+    const float cushionTimes[4] =
+    {
+        motion.x < 0.0f ? (radius - origin.x) / motion.x : 1.0f,
+        motion.x > 0.0f ? (Constants::GAME_WIDTH - radius - origin.x) / motion.x : 1.0f,
+        motion.y < 0.0f ? (radius - origin.y) / motion.y : 1.0f,
+        motion.y > 0.0f ? (Constants::GAME_HEIGHT - radius - origin.y) / motion.y : 1.0f
+    };
+    const vec2 cushionNormals[4] = { vec2(1.0f, 0.0f), vec2(-1.0f, 0.0f), vec2(0.0f, 1.0f), vec2(0.0f, -1.0f) };
+
+    for (int cushion = 0; cushion < 4; cushion++)
+    {
+        if (cushionTimes[cushion] > startTime && cushionTimes[cushion] < hit.Time)
+        {
+            hit.Time = cushionTimes[cushion];
+            hit.Normal = cushionNormals[cushion];
+        }
+    }
+
+    // gaurile: momentul in care centrul bilei intra la DISTANCE_TO_ENTER_HOLE de centrul gaurii
+    for (int hole = 0; hole < (int)holes.size(); hole++)
+    {
+        vec2 p = (origin + motion * startTime) - holes[hole]->GetPosition();
+
+        float c = dot(p, p) - Ball::DISTANCE_TO_ENTER_HOLE * Ball::DISTANCE_TO_ENTER_HOLE;
+        float b = dot(p, motion);
+        if (c <= 0.0f || b >= 0.0f)
+            continue;
+
+        float a = dot(motion, motion);
+        float discriminant = b * b - a * c;
+        if (discriminant < 0.0f)
+            continue;
+
+        float hitTime = startTime + (-b - sqrt(discriminant)) / a;
+        if (hitTime < hit.Time)
+        {
+            hit.Time = hitTime;
+            hit.Hole = hole;
+        }
+    }
+
+    vec2 start = origin + motion * startTime;
+    vec2 end = origin + motion;
+    vec2 bounds = vec2(radius + reach);
+
+    m_quadtree.FindInBox(glm::min(start, end) - bounds, glm::max(start, end) + bounds, nearbyHandles);
+
+    const float* positionX = world.GetPositionsX();
+    const float* positionY = world.GetPositionsY();
+    const float* velocityX = world.GetVelocitiesX();
+    const float* velocityY = world.GetVelocitiesY();
+    const float* radii = world.GetRadii();
+    const unsigned char* flags = world.GetFlags();
+
+    for (auto& handle : nearbyHandles)
+    {
+        int otherSlot = world.GetSlot(handle);
+        if (otherSlot == slot || !(flags[otherSlot] & BallWorld::OnBoardFlag))
+            continue;
+
+        // miscarea relativa de la momentul in care ambele drumuri sunt valabile: |p + w * s| = suma razelor
+        float from = glm::max(startTime, m_sweepTime[otherSlot]);
+        vec2 otherMotion = vec2(velocityX[otherSlot], velocityY[otherSlot]) * travel;
+
+        vec2 p = (origin + motion * from) - (vec2(positionX[otherSlot], positionY[otherSlot]) + otherMotion * from);
+        vec2 w = motion - otherMotion;
+
+        float contactDistance = radius + radii[otherSlot];
+
+        // bilele care se ating deja sunt lasate pentru perechile de la pasul urmator
+        float c = dot(p, p) - contactDistance * contactDistance;
+        float b = dot(p, w);
+        if (c <= 0.0f || b >= 0.0f)
+            continue;
+
+        float a = dot(w, w);
+        float discriminant = b * b - a * c;
+        if (discriminant < 0.0f)
+            continue;
+
+        float hitTime = from + (-b - sqrt(discriminant)) / a;
+
+        // la egalitate castiga handle-ul mai mic, ca rezultatul sa nu depinda de ordinea din arbore
+        bool earlier = hitTime < hit.Time || (hitTime == hit.Time && hit.Other != -1 && handle < world.GetHandle(hit.Other));
+        if (!earlier)
+            continue;
+
+        hit.Time = hitTime;
+        hit.Other = otherSlot;
+        hit.Hole = -1;
+        hit.Normal = normalize(p + w * (hitTime - from));
+    }
+}
+
+void Physics::ResolveSweepHit(const SweepHit& hit, float travel, BallWorld& world)
+{
+    int slot = hit.Slot;
+
+    BallPhysics<float>::State state = { world.GetPosition(slot) + world.GetVelocity(slot) * travel * hit.Time, world.GetVelocity(slot), world.GetRadius(slot), false };
+
+    // bila este dusa in punctul de intrare, unde ResolveHoles ar fi gasit-o daca pasul ar fi fost destul de mic
+    if (hit.Hole != -1)
+    {
+        world.SetPosition(slot, state.Position);
+        PocketBall(world, slot);
+        return;
+    }
+
+    if (hit.Other == -1)
+    {
+        if (BallPhysics<float>::ApplyImpulse(state, hit.Normal))
+            m_shotEvents.Record(world.GetHandle(slot), state.Position, ShotEvents::ContactType::Cushion);
+    }
+    else
+    {
+        BallPhysics<float>::State other = { world.GetPosition(hit.Other) + world.GetVelocity(hit.Other) * travel * hit.Time, world.GetVelocity(hit.Other), world.GetRadius(hit.Other), false };
+
+        RecordContact(world, slot, hit.Other);
+
+        if (BallPhysics<float>::ApplyImpulse(state, other, hit.Normal))
+        {
+            m_shotEvents.Record(world.GetHandle(slot), state.Position, ShotEvents::ContactType::Ball);
+            m_shotEvents.Record(world.GetHandle(hit.Other), other.Position, ShotEvents::ContactType::Ball);
+        }
+
+        world.SetVelocity(hit.Other, other.Velocity);
+        world.SetPosition(hit.Other, other.Position - other.Velocity * travel * hit.Time);
+        m_sweepTime[hit.Other] = hit.Time;
+    }
+
+    world.SetVelocity(slot, state.Velocity);
+    world.SetPosition(slot, state.Position - state.Velocity * travel * hit.Time);
+    m_sweepTime[slot] = hit.Time;
+}
+
+void Physics::UpdateFriction(float deltaTime, BallWorld& world)
+{
+    BallKernels::UpdateFriction(deltaTime, world, m_instructionSet);
+}
+
+void Physics::ResolveHoles(BallWorld& world, const vector<Hole*>& holes)
+{
+    for (int slot = 0; slot < world.GetCount(); slot++)
+    {
+        if (world.IsAsleep(slot))
+            continue;
+
+        for (auto& hole : holes)
+        {
+            vec2 dir = hole->GetPosition() - world.GetPosition(slot);
+            if (length(dir) < Ball::DISTANCE_TO_ENTER_HOLE)
+                PocketBall(world, slot);
+        }
+    }
+}
+
+void Physics::PocketBall(BallWorld& world, int slot)
+{
+    m_shotEvents.Record(world.GetHandle(slot), world.GetPosition(slot), ShotEvents::ContactType::Hole);
+
+    switch (world.GetBallType(slot))
+    {
+    case Ball::BallType::White:
+        world.ResetWhite(slot);
+        m_shotEvents.WhitePocketed = true;
+        break;
+    case Ball::BallType::Black:
+        world.SetVelocity(slot, vec2(0.0f, 0.0f));
+        world.SetOnBoard(slot, false);
+        break;
+    case Ball::BallType::Normal:
+        world.SetVelocity(slot, vec2(0.0f, 0.0f));
+        world.SetOnBoard(slot, false);
+        break;
+    }
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+#include <vector>
+#include <utility>
+#include <glm/glm.hpp>
+
+#include "BallKernels.h"
+#include "BallWorld.h"
+#include "ContactSolver.h"
+#include "EventSolver.h"
+#include "Hole.h"
+#include "LooseQuadtree.h"
+#include "ShotEvents.h"
+#include "TableState.h"
+
+// Pasul de fizica pentru toate bilele dintr-un BallWorld: coliziuni intre bile, cu peretii, frecare si gauri.
+// Poate merge cu pas fix (TimeStepped), cu pas fix si impulsuri secventiale pentru contactele dintre bile (SequentialImpulse,
+// pentru grupurile de bile lipite, ca triunghiul de la inceput) sau cu EventSolver, care sare direct de la un impact la altul.
+// In modul determinist rezultatul lui Update depinde doar de starea initiala si de timpul total simulat: pasul este mereu
+// DETERMINISTIC_STEP, iar perechile de bile sunt colorate in ordinea handle-urilor, nu in ordinea din arbore.
+// UpdateUntilRest foloseste pasul primit si in modul determinist.
+// Contactele dintre bile sunt rezolvate de ContactSolver, pe loturi independente, in paralel daca Physics are un ThreadPool.
+// Pasul cu pas fix este impartit in subpasi, destui cat nicio bila sa nu treaca intr-unul mai mult de fractiunea data
+// de SetSubstepFraction din raza ei (cel mult MAX_SUBSTEPS); cand bilele merg incet ramane un singur subpas, iar cand
+// toate stau pe loc niciunul. Numarul de subpasi depinde doar de vitezele bilelor, deci si modul determinist ramane determinist.
+// Bilele care ar trece intr-un pas intreg mai mult de CCD_DISPLACEMENT_FRACTION din raza lor sunt urmarite continuu (CCD)
+// in fiecare subpas: momentul impactului cu alte bile, cu peretii si cu gaurile este calculat pe drumul lor din subpas,
+// ca sa nu sara peste ele. Pragul nu depinde de subpasi, asa ca subpasii mai mici doar adauga precizie peste CCD.
+class Physics
+{
+public:
+
+    enum class Solver
+    {
+        TimeStepped,
+        EventDriven,
+        SequentialImpulse
+    };
+
+    // Pasii si subpasii facuti de la ultimul ResetStepStatistics (de obicei de la inceputul loviturii).
+    struct StepStatistics
+    {
+    public:
+
+        StepStatistics();
+
+    public:
+
+        int Steps;
+        int Substeps;
+        int MaxSubsteps;
+        int LastSubsteps;
+    };
+
+public:
+
+    static const float DETERMINISTIC_STEP;
+    static const float DEFAULT_SUBSTEP_FRACTION;
+
+private:
+
+    // Primul impact gasit de CCD pentru bila din Slot: cu bila din slotul Other, cu gaura Hole sau, daca ambele sunt -1, cu un perete.
+    struct SweepHit
+    {
+        float     Time;
+        int       Slot;
+        int       Other;
+        int       Hole;
+        glm::vec2 Normal;
+    };
+
+private:
+
+    static const float CCD_DISPLACEMENT_FRACTION;
+    static const int   MAX_STEPS_UNTIL_REST = 100000;
+    static const int   MAX_SUBSTEPS         = 16;
+    static const int   MAX_SWEEP_PASSES     = 4;
+    static const int   SWEEP_GRAIN          = 256;
+
+public:
+
+    Physics();
+
+    void                        Update(float, BallWorld&, const std::vector<Hole*>&);
+    float                       UpdateUntilRest(float, BallWorld&, const std::vector<Hole*>&);
+    void                        RemovePocketed(BallWorld&);
+
+    void                        SaveState(TableState&) const;
+    void                        RestoreState(const TableState&, const BallWorld&);
+
+    void                        SetSolver(Solver);
+    Solver                      GetSolver() const;
+
+    void                        SetContactIterations(int);
+    int                         GetContactIterations() const;
+
+    void                        SetDeterministic(bool);
+    bool                        IsDeterministic() const;
+
+    void                        ResetShotEvents();
+    const ShotEvents&           GetShotEvents() const;
+    void                        SetContactRecording(bool);
+
+    void                        ResetStepStatistics();
+    const StepStatistics&       GetStepStatistics() const;
+
+    void                        SetSubstepFraction(float);
+    float                       GetSubstepFraction() const;
+
+    void                        SetThreadPool(ThreadPool*);
+    ThreadPool*                 GetThreadPool() const;
+
+    void                        SetInstructionSet(BallKernels::InstructionSet);
+    BallKernels::InstructionSet GetInstructionSet() const;
+
+private:
+
+    void  Step(float, BallWorld&, const std::vector<Hole*>&);
+    void  Substep(float, float, BallWorld&, const std::vector<Hole*>&);
+    int   GetSubstepCount(float, const BallWorld&) const;
+    void  WakeTouchedBalls(float, BallWorld&);
+    void  SleepStoppedBalls(BallWorld&);
+    void  RecordContact(BallWorld&, int, int);
+    void  ResolveCushion(BallWorld&, int, glm::vec2, float);
+    void  ResolveWallColissions(BallWorld&);
+    void  SweepFastBalls(float, float, BallWorld&, const std::vector<Hole*>&);
+    void  SweepBall(int, float, float, const BallWorld&, const std::vector<Hole*>&, std::vector<int>&, SweepHit&) const;
+    void  ResolveSweepHit(const SweepHit&, float, BallWorld&);
+    void  UpdateFriction(float, BallWorld&);
+    void  ResolveHoles(BallWorld&, const std::vector<Hole*>&);
+    void  PocketBall(BallWorld&, int);
+
+private:
+
+    LooseQuadtree                    m_quadtree;
+    std::vector<std::pair<int, int>> m_colissionPairs;
+    std::vector<int>                 m_nearbyHandles;
+    ContactSolver                    m_contactSolver;
+    ThreadPool*                      m_threadPool;
+
+    // pentru CCD: momentul din pas (0..1) de la care drumul fiecarei bile este pozitie + viteza * timp, primul impact
+    // al fiecarei bile in trecerea curenta, trecerea in care a fost lovita ultima data, trecerea in care trebuie cautata
+    // din nou si bilele gasite de fiecare worker
+    std::vector<float>               m_sweepTime;
+    std::vector<SweepHit>            m_sweepHits;
+    std::vector<int>                 m_sweepPass;
+    std::vector<int>                 m_sweepNext;
+    std::vector<std::vector<int>>    m_workerHandles;
+
+    BallKernels::InstructionSet      m_instructionSet;
+
+    Solver                           m_solver;
+    int                              m_contactIterations;
+    float                            m_substepFraction;
+    EventSolver                      m_eventSolver;
+
+    bool                             m_deterministic;
+    float                            m_accumulator;
+
+    ShotEvents                       m_shotEvents;
+    StepStatistics                   m_stepStatistics;
+};
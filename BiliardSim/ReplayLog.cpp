@@ -0,0 +1,169 @@
+#include "ReplayLog.h"
+
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+using namespace glm;
+
+// "BRPL" citit ca intreg little-endian
+const unsigned int ReplayLog::MAGIC          = 0x4C505242;
+
+// creste si cand se schimba fizica, pentru ca un meci inregistrat inainte nu s-ar mai juca la fel
+// 2: CCD pentru bilele rapide
+// 3: contactele dintre bile rezolvate pe loturi colorate
+// 4: pasul impartit in subpasi dupa viteza celei mai rapide bile
+// 5: EventSolver pastreaza predictiile intre apeluri
+const unsigned int ReplayLog::FORMAT_VERSION = 5;
+
+ReplayLog::ReplayLog(unsigned int seed, Physics::Solver solver) :
+    m_seed(seed),
+    m_solver(solver)
+{
+}
+
+// Scrie antetul si loviturile de pana acum; cele urmatoare sunt adaugate de AddShot.
+bool ReplayLog::StartRecording(const string& filename)
+{
+    StopRecording();
+
+    m_file.open(filename, ios::binary | ios::trunc);
+    if (!m_file)
+    {
+        cout << "ERROR::REPLAY::FILE_NOT_SUCCESFULLY_OPENED " << filename << endl;
+        return false;
+    }
+
+    unsigned char header[HEADER_SIZE];
+    WriteUnsigned(header, MAGIC);
+    WriteUnsigned(header + 4, FORMAT_VERSION);
+    WriteUnsigned(header + 8, m_seed);
+    WriteUnsigned(header + 12, (unsigned int)m_solver);
+
+    m_file.write((const char*)header, HEADER_SIZE);
+
+    for (auto& shot : m_shots)
+    {
+        unsigned char record[SHOT_SIZE];
+        WriteFloat(record, shot.x);
+        WriteFloat(record + 4, shot.y);
+
+        m_file.write((const char*)record, SHOT_SIZE);
+    }
+
+    m_file.flush();
+
+    return true;
+}
+
+void ReplayLog::StopRecording()
+{
+    if (m_file.is_open())
+        m_file.close();
+}
+
+bool ReplayLog::IsRecording() const
+{
+    return m_file.is_open();
+}
+
+// Lovitura este scrisa imediat, ca fisierul sa fie complet chiar daca jocul este oprit brusc.
+void ReplayLog::AddShot(vec2 velocity)
+{
+    m_shots.push_back(velocity);
+
+    if (!m_file.is_open())
+        return;
+
+    unsigned char record[SHOT_SIZE];
+    WriteFloat(record, velocity.x);
+    WriteFloat(record + 4, velocity.y);
+
+    m_file.write((const char*)record, SHOT_SIZE);
+    m_file.flush();
+}
+
+// Un ultim record incomplet (de exemplu scris pe jumatate la o oprire brusca) este ignorat.
+bool ReplayLog::Load(const string& filename)
+{
+    StopRecording();
+
+    ifstream file(filename, ios::binary);
+    if (!file)
+    {
+        cout << "ERROR::REPLAY::FILE_NOT_SUCCESFULLY_READ " << filename << endl;
+        return false;
+    }
+
+    unsigned char header[HEADER_SIZE];
+    if (!file.read((char*)header, HEADER_SIZE) || ReadUnsigned(header) != MAGIC)
+    {
+        cout << "ERROR::REPLAY::INVALID_HEADER " << filename << endl;
+        return false;
+    }
+
+    if (ReadUnsigned(header + 4) != FORMAT_VERSION)
+    {
+        cout << "ERROR::REPLAY::UNSUPPORTED_VERSION " << ReadUnsigned(header + 4) << endl;
+        return false;
+    }
+
+    m_seed = ReadUnsigned(header + 8);
+    m_solver = (Physics::Solver)ReadUnsigned(header + 12);
+    m_shots.clear();
+
+    unsigned char record[SHOT_SIZE];
+    while (file.read((char*)record, SHOT_SIZE))
+        m_shots.push_back(vec2(ReadFloat(record), ReadFloat(record + 4)));
+
+    return true;
+}
+
+unsigned int ReplayLog::GetSeed() const
+{
+    return m_seed;
+}
+
+Physics::Solver ReplayLog::GetSolver() const
+{
+    return m_solver;
+}
+
+int ReplayLog::GetShotCount() const
+{
+    return (int)m_shots.size();
+}
+
+vec2 ReplayLog::GetShot(int index) const
+{
+    return m_shots[index];
+}
+
+void ReplayLog::WriteUnsigned(unsigned char* bytes, unsigned int value)
+{
+    bytes[0] = (unsigned char)(value);
+    bytes[1] = (unsigned char)(value >> 8);
+    bytes[2] = (unsigned char)(value >> 16);
+    bytes[3] = (unsigned char)(value >> 24);
+}
+
+unsigned int ReplayLog::ReadUnsigned(const unsigned char* bytes)
+{
+    return (unsigned int)bytes[0] | ((unsigned int)bytes[1] << 8) | ((unsigned int)bytes[2] << 16) | ((unsigned int)bytes[3] << 24);
+}
+
+void ReplayLog::WriteFloat(unsigned char* bytes, float value)
+{
+    unsigned int bits;
+    memcpy(&bits, &value, sizeof(bits));
+    WriteUnsigned(bytes, bits);
+}
+
+float ReplayLog::ReadFloat(const unsigned char* bytes)
+{
+    unsigned int bits = ReadUnsigned(bytes);
+
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
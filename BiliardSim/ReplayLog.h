@@ -0,0 +1,57 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Physics.h"
+
+// Un meci inregistrat: samanta cu care a fost asezata masa, solverul si loviturile (vitezele date bilei albe), in ordine.
+// Fisierul are un antet de HEADER_SIZE octeti, urmat de SHOT_SIZE octeti pentru fiecare lovitura. Loviturile sunt
+// adaugate la final pe masura ce sunt date, asa ca un meci intrerupt ramane citibil pana la ultima lovitura scrisa.
+// Toate valorile sunt scrise little-endian, indiferent de platforma.
+class ReplayLog
+{
+public:
+
+    static const unsigned int MAGIC;
+    static const unsigned int FORMAT_VERSION;
+
+    static const int          HEADER_SIZE = 16;
+    static const int          SHOT_SIZE   = 8;
+
+public:
+
+    ReplayLog(unsigned int = 0, Physics::Solver = Physics::Solver::TimeStepped);
+
+    bool                      StartRecording(const std::string&);
+    void                      StopRecording();
+    bool                      IsRecording() const;
+
+    void                      AddShot(glm::vec2);
+    bool                      Load(const std::string&);
+
+    unsigned int              GetSeed()      const;
+    Physics::Solver           GetSolver()    const;
+    int                       GetShotCount() const;
+    glm::vec2                 GetShot(int)   const;
+
+private:
+
+    static void               WriteUnsigned(unsigned char*, unsigned int);
+    static unsigned int       ReadUnsigned(const unsigned char*);
+
+    static void               WriteFloat(unsigned char*, float);
+    static float              ReadFloat(const unsigned char*);
+
+private:
+
+    unsigned int              m_seed;
+    Physics::Solver           m_solver;
+    std::vector<glm::vec2>    m_shots;
+
+    std::ofstream             m_file;
+};
@@ -0,0 +1,101 @@
+#include "ReplayPlayer.h"
+
+using namespace std;
+
+ReplayPlayer::ReplayPlayer(const ReplayLog& log, int keyframeInterval) :
+    m_log(log),
+    m_keyframeInterval(keyframeInterval),
+    m_table(log.GetSeed()),
+    m_shot(0)
+{
+    m_table.GetPhysics().SetSolver(m_log.GetSolver());
+    m_table.GetPhysics().SetDeterministic(true);
+    // fara stare initiala nu se poate cauta inapoi, deci nici copiile intermediare nu ar folosi la nimic
+    m_hasInitialState = m_table.SaveState(m_initialState);
+    if (!m_hasInitialState)
+        m_keyframeInterval = 0;
+
+    StoreKeyframe();
+}
+
+// Simuleaza urmatoarea lovitura; intoarce false daca nu mai sunt lovituri sau meciul s-a terminat.
+bool ReplayPlayer::Step()
+{
+    if (m_shot >= m_log.GetShotCount())
+        return false;
+
+    if (!m_table.ApplyShot(m_log.GetShot(m_shot)))
+        return false;
+
+    // la fel ca Game::FixedUpdate: regulile sunt aplicate dupa fiecare pas, deci bilele bagate in gauri sunt scoase
+    // si meciul se poate termina in aceleasi momente ca in jocul inregistrat
+    for (int step = 0; step < MAX_STEPS_PER_SHOT && m_table.GetGameState() == Table::GameState::Waiting; step++)
+        m_table.Update(Physics::DETERMINISTIC_STEP);
+
+    m_shot++;
+
+    StoreKeyframe();
+
+    return true;
+}
+
+// Aduce masa in starea de dupa primele shot lovituri.
+void ReplayPlayer::Seek(int shot)
+{
+    if (shot < 0)
+        shot = 0;
+
+    if (shot > m_log.GetShotCount())
+        shot = m_log.GetShotCount();
+
+    if (m_keyframeInterval > 0)
+    {
+        int keyframe = shot / m_keyframeInterval;
+        if (keyframe >= (int)m_keyframes.size())
+            keyframe = (int)m_keyframes.size() - 1;
+
+        // o stare salvata este folosita doar daca este mai aproape decat starea curenta
+        int keyframeShot = keyframe * m_keyframeInterval;
+        if ((shot < m_shot || keyframeShot > m_shot) && m_table.RestoreState(m_keyframes[keyframe]))
+            m_shot = keyframeShot;
+    }
+    else if (shot < m_shot && m_hasInitialState && m_table.RestoreState(m_initialState))
+    {
+        m_shot = 0;
+    }
+
+    while (m_shot < shot && Step())
+    {
+    }
+}
+
+void ReplayPlayer::PlayToEnd()
+{
+    while (Step())
+    {
+    }
+}
+
+int ReplayPlayer::GetShot() const
+{
+    return m_shot;
+}
+
+const Table& ReplayPlayer::GetTable() const
+{
+    return m_table;
+}
+
+void ReplayPlayer::StoreKeyframe()
+{
+    if (m_keyframeInterval <= 0 || m_shot % m_keyframeInterval != 0)
+        return;
+
+    // o copie care nu a putut fi salvata lipseste, iar cele de dupa ea nu mai sunt pastrate
+    if (m_shot / m_keyframeInterval != (int)m_keyframes.size())
+        return;
+
+    m_keyframes.push_back(TableState());
+    if (!m_table.SaveState(m_keyframes.back()))
+        m_keyframes.pop_back();
+}
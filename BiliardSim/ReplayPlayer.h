@@ -0,0 +1,54 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+#include <vector>
+
+#include "ReplayLog.h"
+#include "Table.h"
+#include "TableState.h"
+
+// Reface un meci din ReplayLog fara fereastra: fiecare lovitura este simulata pana la oprirea bilelor, cat de repede se poate.
+// Masa merge in modul determinist si este actualizata cu cate un DETERMINISTIC_STEP, ca in joc (unde pasul fizicii
+// este acelasi), deci ajunge exact in aceleasi stari ca meciul inregistrat.
+// Dupa fiecare KeyframeInterval lovituri este pastrata starea mesei (TableState); Seek porneste de la cea mai apropiata,
+// asa ca dupa prima trecere prin meci o cautare simuleaza cel mult KeyframeInterval - 1 lovituri. Cu 0 nu se pastreaza copii.
+class ReplayPlayer
+{
+public:
+
+    static const int DEFAULT_KEYFRAME_INTERVAL = 8;
+
+private:
+
+    static const int MAX_STEPS_PER_SHOT        = 100000;
+
+public:
+
+    ReplayPlayer(const ReplayLog&, int = DEFAULT_KEYFRAME_INTERVAL);
+
+    bool         Step();
+    void         Seek(int);
+    void         PlayToEnd();
+
+    int          GetShot()  const;
+    const Table& GetTable() const;
+
+private:
+
+    void         StoreKeyframe();
+
+private:
+
+    const ReplayLog&        m_log;
+    int                     m_keyframeInterval;
+
+    Table                   m_table;
+    int                     m_shot;
+
+    TableState              m_initialState;
+    bool                    m_hasInitialState;
+
+    // m_keyframes[i] este starea dupa i * m_keyframeInterval lovituri
+    std::vector<TableState> m_keyframes;
+};
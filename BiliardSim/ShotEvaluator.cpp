@@ -0,0 +1,153 @@
+#include "ShotEvaluator.h"
+
+#include <chrono>
+
+using namespace std;
+using namespace glm;
+
+ShotEvaluator::ShotOutcome::ShotOutcome() :
+    WhiteBallPosition(0.0f, 0.0f),
+    Fouls(NoFoul),
+    Time(0.0f),
+    Substeps(0)
+{
+}
+
+ShotEvaluator::Statistics::Statistics() :
+    Shots(0),
+    Threads(0),
+    Seconds(0.0f),
+    ShotsPerSecondPerThread(0.0f)
+{
+}
+
+ShotEvaluator::ShotEvaluator(int threadCount) :
+    m_pool(threadCount),
+    m_fastMode(false)
+{
+    for (int worker = 0; worker < m_pool.GetWorkerCount(); worker++)
+        m_workers.push_back(new Worker());
+}
+
+ShotEvaluator::~ShotEvaluator()
+{
+    for (auto& worker : m_workers)
+    {
+        if (worker)
+        {
+            delete worker;
+            worker = nullptr;
+        }
+    }
+    m_workers.clear();
+}
+
+// Pasul este folosit doar cand masa merge cu Physics::Solver::TimeStepped sau SequentialImpulse.
+void ShotEvaluator::Evaluate(const Table& table, const vector<vec2>& shots, vector<ShotOutcome>& outcomes, float deltaTime)
+{
+    auto start = chrono::steady_clock::now();
+
+    outcomes.resize(shots.size());
+
+    // Fizica mesei se copiaza o data pe apel, iar din ea workerii isi iau o copie pentru fiecare lovitura, impreuna cu bilele,
+    // refolosind memoria lor; asa nicio lovitura nu vede arborele sau contactele ramase de la lovitura de dinainte.
+    // Workerii ruleaza deja pe pool-ul evaluatorului, asa ca nu folosesc si pool-ul mesei; rezultatul nu depinde de pool.
+    m_simulation = table.GetPhysics();
+    m_simulation.SetThreadPool(nullptr);
+
+    if (m_fastMode)
+        m_simulation.SetSubstepFraction(0.0f);
+
+    m_pool.ParallelFor((int)shots.size(), 1, [&](int index, int worker)
+    {
+        EvaluateShot(table, shots[index], outcomes[index], deltaTime, *m_workers[worker]);
+    });
+
+    float seconds = chrono::duration<float>(chrono::steady_clock::now() - start).count();
+
+    m_statistics.Shots = (int)shots.size();
+    m_statistics.Threads = GetThreadCount();
+    m_statistics.Seconds = seconds;
+    m_statistics.ShotsPerSecondPerThread = seconds > 0.0f ? m_statistics.Shots / (seconds * m_statistics.Threads) : 0.0f;
+}
+
+void ShotEvaluator::SetFastMode(bool fastMode)
+{
+    m_fastMode = fastMode;
+}
+
+bool ShotEvaluator::IsFastMode() const
+{
+    return m_fastMode;
+}
+
+int ShotEvaluator::GetThreadCount() const
+{
+    return m_pool.GetWorkerCount();
+}
+
+const ShotEvaluator::Statistics& ShotEvaluator::GetStatistics() const
+{
+    return m_statistics;
+}
+
+void ShotEvaluator::EvaluateShot(const Table& table, vec2 velocity, ShotOutcome& outcome, float deltaTime, Worker& worker)
+{
+    const BallWorld& source = table.GetWorld();
+    BallWorld& world = worker.World;
+
+    world = source;
+    world.GetBall(table.GetWhiteBall()).SetVelocity(velocity);
+
+    worker.Simulation = m_simulation;
+    worker.Simulation.ResetShotEvents();
+    worker.Simulation.ResetStepStatistics();
+    outcome.Time = worker.Simulation.UpdateUntilRest(deltaTime, world, table.GetHoles());
+    outcome.Substeps = worker.Simulation.GetStepStatistics().Substeps;
+
+    const Table::PlayerDetails& player = table.GetPlayerDetails(table.GetCurrentPlayer());
+    BallWorld::BallMask allowedBalls = player.AllowedBalls;
+
+    outcome.PocketedBalls.clear();
+    outcome.Fouls = Fouls::NoFoul;
+    outcome.WhiteBallPosition = world.GetBall(table.GetWhiteBall()).GetPosition();
+
+    for (int slot = 0; slot < world.GetCount(); slot++)
+    {
+        if (world.OnBoard(slot) || !source.OnBoard(slot))
+            continue;
+
+        int handle = world.GetHandle(slot);
+        outcome.PocketedBalls.push_back(handle);
+
+        if (world.GetBallType(slot) == Ball::BallType::Black)
+        {
+            if (!player.FinishedBalls)
+                outcome.Fouls |= Fouls::BlackBallFoul;
+        }
+        else if (!(allowedBalls & BallWorld::HandleBit(handle)))
+        {
+            outcome.Fouls |= Fouls::OpponentBallFoul;
+        }
+    }
+
+    const ShotEvents& shotEvents = worker.Simulation.GetShotEvents();
+
+    if (shotEvents.WhitePocketed)
+        outcome.Fouls |= Fouls::ScratchFoul;
+
+    if (shotEvents.FirstWhiteContact == -1)
+    {
+        outcome.Fouls |= Fouls::NoContactFoul;
+    }
+    else
+    {
+        int firstSlot = world.GetSlot(shotEvents.FirstWhiteContact);
+        bool allowed = world.GetBallType(firstSlot) == Ball::BallType::Black ?
+            player.FinishedBalls :
+            (allowedBalls & BallWorld::HandleBit(shotEvents.FirstWhiteContact)) != 0;
+
+        if (!allowed)
+            outcome.Fouls |= Fouls::WrongBallFirstFoul;
+    }
+}
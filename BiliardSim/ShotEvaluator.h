@@ -0,0 +1,97 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "BallWorld.h"
+#include "Physics.h"
+#include "Table.h"
+#include "ThreadPool.h"
+
+// Evalueaza in paralel multe lovituri posibile pornind de la aceeasi stare a mesei.
+// Fiecare lovitura este viteza data bilei albe (ca in Table::ApplyShot) si este simulata pana la oprirea bilelor
+// pe o copie a bilelor, asa ca masa originala nu se schimba.
+// Pasul implicit este Physics::DETERMINISTIC_STEP, acelasi cu al mesei, iar fiecare lovitura porneste de la o copie
+// proaspata a fizicii mesei (arbore, contacte din cache), asa ca pe o masa determinista rezultatul este cel pe care
+// l-ar da masa si nu depinde de workerul care a simulat lovitura. Un pas mai mare este mai ieftin, dar loviturile
+// pot iesi altfel decat pe masa. La fel in modul rapid (SetFastMode), in care pasii nu mai sunt impartiti in subpasi.
+class ShotEvaluator
+{
+public:
+
+    enum Fouls
+    {
+        NoFoul             = 0,
+        ScratchFoul        = 1 << 0,
+        NoContactFoul      = 1 << 1,
+        WrongBallFirstFoul = 1 << 2,
+        OpponentBallFoul   = 1 << 3,
+        BlackBallFoul      = 1 << 4
+    };
+
+    struct ShotOutcome
+    {
+    public:
+
+        ShotOutcome();
+
+    public:
+
+        std::vector<int> PocketedBalls;
+        glm::vec2        WhiteBallPosition;
+        int              Fouls;
+        float            Time;
+
+        // subpasii de fizica facuti pentru lovitura, adica costul ei (vezi Physics::SetSubstepFraction)
+        int              Substeps;
+    };
+
+    struct Statistics
+    {
+    public:
+
+        Statistics();
+
+    public:
+
+        int   Shots;
+        int   Threads;
+        float Seconds;
+        float ShotsPerSecondPerThread;
+    };
+
+public:
+
+    ShotEvaluator(int = 0);
+    ~ShotEvaluator();
+
+    void              Evaluate(const Table&, const std::vector<glm::vec2>&, std::vector<ShotOutcome>&, float = Physics::DETERMINISTIC_STEP);
+
+    void              SetFastMode(bool);
+    bool              IsFastMode()     const;
+
+    int               GetThreadCount() const;
+    const Statistics& GetStatistics()  const;
+
+private:
+
+    struct Worker
+    {
+        BallWorld World;
+        Physics   Simulation;
+    };
+
+private:
+
+    void EvaluateShot(const Table&, glm::vec2, ShotOutcome&, float, Worker&);
+
+private:
+
+    ThreadPool           m_pool;
+    std::vector<Worker*> m_workers;
+    Physics              m_simulation;
+    Statistics           m_statistics;
+    bool                 m_fastMode;
+};
@@ -0,0 +1,23 @@
+#include "ShotEvents.h"
+
+using namespace glm;
+
+ShotEvents::ShotEvents() :
+    FirstWhiteContact(-1),
+    WhitePocketed(false),
+    RecordContacts(false)
+{
+}
+
+void ShotEvents::Reset()
+{
+    FirstWhiteContact = -1;
+    WhitePocketed = false;
+    Contacts.clear();
+}
+
+void ShotEvents::Record(int handle, vec2 position, ContactType type)
+{
+    if (RecordContacts)
+        Contacts.push_back({ handle, position, type });
+}
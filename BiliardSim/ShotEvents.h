@@ -0,0 +1,43 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+#include <vector>
+#include <glm/glm.hpp>
+
+// Ce s-a intamplat cu bila alba in timpul unei lovituri; folosit la evaluarea greselilor.
+// Daca RecordContacts este setat, fiecare impact (cu alta bila, cu peretele sau cu o gaura) este pastrat in
+// Contacts, in ordinea in care s-a intamplat, cu pozitia bilei in acel moment (vezi TrajectoryPredictor).
+struct ShotEvents
+{
+public:
+
+    enum class ContactType
+    {
+        Ball,
+        Cushion,
+        Hole
+    };
+
+    struct Contact
+    {
+        int         Handle;
+        glm::vec2   Position;
+        ContactType Type;
+    };
+
+public:
+
+    ShotEvents();
+
+    void Reset();
+    void Record(int, glm::vec2, ContactType);
+
+public:
+
+    int                  FirstWhiteContact;
+    bool                 WhitePocketed;
+
+    bool                 RecordContacts;
+    std::vector<Contact> Contacts;
+};
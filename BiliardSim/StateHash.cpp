@@ -0,0 +1,35 @@
+#include "StateHash.h"
+
+const unsigned long long StateHash::OFFSET_BASIS = 14695981039346656037ULL;
+const unsigned long long StateHash::PRIME        = 1099511628211ULL;
+
+StateHash::StateHash() :
+    m_hash(OFFSET_BASIS)
+{
+}
+
+void StateHash::Add(const void* data, int size)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+
+    for (int i = 0; i < size; i++)
+    {
+        m_hash ^= bytes[i];
+        m_hash *= PRIME;
+    }
+}
+
+void StateHash::Add(int value)
+{
+    Add(&value, sizeof(value));
+}
+
+void StateHash::Add(float value)
+{
+    Add(&value, sizeof(value));
+}
+
+unsigned long long StateHash::Get() const
+{
+    return m_hash;
+}
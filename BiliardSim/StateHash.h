@@ -0,0 +1,27 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+// FNV-1a pe 64 de biti peste reprezentarea exacta a valorilor adaugate. Doua stari au acelasi hash doar daca
+// sunt identice bit cu bit (inclusiv 0.0f fata de -0.0f), ceea ce este exact ce trebuie verificat in modul determinist.
+class StateHash
+{
+private:
+
+    static const unsigned long long OFFSET_BASIS;
+    static const unsigned long long PRIME;
+
+public:
+
+    StateHash();
+
+    void               Add(const void*, int);
+    void               Add(int);
+    void               Add(float);
+
+    unsigned long long Get() const;
+
+private:
+
+    unsigned long long m_hash;
+};
@@ -0,0 +1,619 @@
+#include "Table.h"
+
+#include <cmath>
+#include <iostream>
+#include <utility>
+
+#include "Constants.h"
+
+using namespace std;
+using namespace glm;
+
+const float Table::NORMAL_BALLS_OFFSET       = 100.0f;
+const float Table::NORMAL_BALLS_DIST_BETWEEN = 50.0f;
+const float Table::HOLE_BIAS                 = 15.0f;
+const float Table::HOLE_RADIUS               = 30.0f;
+
+Table::PlayerDetails::PlayerDetails() :
+    Score(0),
+    Dead(false),
+    AllowedBalls(0),
+    FinishedBalls(false)
+{
+}
+
+Table::Table(unsigned int seed) :
+    m_whiteBall(-1),
+    m_blackBall(-1),
+    m_seed(seed),
+    m_version(0),
+    m_gameState(Table::GameState::Playing),
+    m_currentPlayer(Table::Players::Player1)
+{
+    m_playerDetails[(int)Players::Player1] = PlayerDetails();
+    m_playerDetails[(int)Players::Player2] = PlayerDetails();
+    cout << "Este randul jucatorului " << (m_currentPlayer + 1) << "." << endl;
+
+    CreateBalls();
+    CreateHoles();
+}
+
+Table::Table(const Table& other) :
+    m_world(other.m_world),
+    m_physics(other.m_physics),
+    m_whiteBall(other.m_whiteBall),
+    m_blackBall(other.m_blackBall),
+    m_seed(other.m_seed),
+    m_version(other.m_version),
+    m_gameState(other.m_gameState),
+    m_currentPlayer(other.m_currentPlayer)
+{
+    m_playerDetails[(int)Players::Player1] = other.m_playerDetails[(int)Players::Player1];
+    m_playerDetails[(int)Players::Player2] = other.m_playerDetails[(int)Players::Player2];
+
+    CopyHoles(other);
+}
+
+Table::~Table()
+{
+    FreeHoles();
+}
+
+Table& Table::operator=(const Table& other)
+{
+    if (this == &other)
+        return *this;
+
+    m_world = other.m_world;
+    m_physics = other.m_physics;
+    m_whiteBall = other.m_whiteBall;
+    m_blackBall = other.m_blackBall;
+    m_seed = other.m_seed;
+    m_version = other.m_version;
+    m_gameState = other.m_gameState;
+    m_currentPlayer = other.m_currentPlayer;
+    m_playerDetails[(int)Players::Player1] = other.m_playerDetails[(int)Players::Player1];
+    m_playerDetails[(int)Players::Player2] = other.m_playerDetails[(int)Players::Player2];
+
+    FreeHoles();
+    CopyHoles(other);
+
+    return *this;
+}
+
+void Table::Update(float deltaTime)
+{
+    if (m_gameState == GameState::Finished)
+        return;
+
+    // cat timp se asteapta o lovitura toate bilele dorm, asa ca pasul nu schimba nimic
+    if (m_gameState == GameState::Waiting)
+        m_version++;
+
+    m_physics.Update(deltaTime, m_world, m_holes);
+    ApplyRules();
+}
+
+bool Table::ApplyShot(vec2 velocity)
+{
+    if (m_gameState != GameState::Playing)
+        return false;
+
+    m_world.GetBall(m_whiteBall).SetVelocity(velocity);
+    m_physics.ResetShotEvents();
+    m_physics.ResetStepStatistics();
+    m_gameState = GameState::Waiting;
+    m_version++;
+
+    return true;
+}
+
+// Simuleaza lovitura curenta pana cand bilele se opresc (sau jocul se termina) si intoarce timpul simulat.
+// Pasul este folosit doar de Physics::Solver::TimeStepped si SequentialImpulse.
+float Table::UpdateUntilRest(float deltaTime)
+{
+    if (m_gameState != GameState::Waiting)
+        return 0.0f;
+
+    float time = m_physics.UpdateUntilRest(deltaTime, m_world, m_holes);
+    ApplyRules();
+    m_version++;
+
+    return time;
+}
+
+bool Table::SaveState(TableState& state) const
+{
+    if (!m_world.SaveState(state))
+        return false;
+
+    m_physics.SaveState(state);
+
+    state.Seed = m_seed;
+    state.WhiteBall = m_whiteBall;
+    state.BlackBall = m_blackBall;
+    state.GameState = (int)m_gameState;
+    state.CurrentPlayer = (int)m_currentPlayer;
+
+    for (int player = 0; player < 2; player++)
+    {
+        const PlayerDetails& details = m_playerDetails[player];
+        TableState::PlayerState& playerState = state.Players[player];
+
+        playerState.Score = details.Score;
+        playerState.Dead = details.Dead;
+        playerState.FinishedBalls = details.FinishedBalls;
+        playerState.AllowedBalls = details.AllowedBalls;
+    }
+
+    return true;
+}
+
+// Nu aloca memorie daca masa a avut deja cel putin atatea bile (de exemplu daca a fost creata cu aceeasi samanta).
+// Intoarce false, fara sa schimbe masa, daca starea nu este valida: campurile mesei si ale fizicii sunt verificate aici,
+// cele ale bilelor in BallWorld::RestoreState, care este prima schimbare si dupa care nimic nu mai poate esua.
+// Versiunea nu este restaurata, ci doar crescuta, ca rezultatele tinute in cache pentru starea veche sa nu fie refolosite.
+bool Table::RestoreState(const TableState& state)
+{
+    if (!IsValidState(state))
+        return false;
+
+    if (!m_world.RestoreState(state))
+        return false;
+
+    m_physics.RestoreState(state, m_world);
+
+    m_seed = state.Seed;
+    m_whiteBall = state.WhiteBall;
+    m_blackBall = state.BlackBall;
+    m_gameState = (GameState)state.GameState;
+    m_currentPlayer = (Players)state.CurrentPlayer;
+
+    for (int player = 0; player < 2; player++)
+    {
+        PlayerDetails& details = m_playerDetails[player];
+        const TableState::PlayerState& playerState = state.Players[player];
+
+        details.Score = playerState.Score;
+        details.Dead = playerState.Dead;
+        details.FinishedBalls = playerState.FinishedBalls;
+        details.AllowedBalls = playerState.AllowedBalls;
+    }
+
+    m_version++;
+
+    return true;
+}
+
+// Bilele sunt verificate de BallWorld::RestoreState; aici doar handle-urile la care trimite restul starii.
+bool Table::IsValidState(const TableState& state) const
+{
+    int handleCount = state.HandleCount;
+    int ballCount = glm::clamp(state.BallCount, 0, (int)TableState::MAX_BALLS);
+
+    if (state.GameState < GameState::Playing || state.GameState > GameState::Finished)
+    {
+        cout << "ERROR::TABLE::INVALID_GAME_STATE " << state.GameState << endl;
+        return false;
+    }
+
+    if (state.CurrentPlayer < Players::Player1 || state.CurrentPlayer > Players::Player2)
+    {
+        cout << "ERROR::TABLE::INVALID_CURRENT_PLAYER " << state.CurrentPlayer << endl;
+        return false;
+    }
+
+    // bila alba nu este scoasa niciodata de pe masa; cea neagra poate lipsi doar daca a fost bagata in gaura
+    bool whiteFound = false;
+    bool blackValid = state.BlackBall >= 0 && state.BlackBall < handleCount;
+    for (int slot = 0; slot < ballCount; slot++)
+    {
+        const TableState::BallState& ball = state.Balls[slot];
+
+        if (ball.Handle == state.WhiteBall)
+            whiteFound = ball.Type == Ball::BallType::White;
+        if (ball.Handle == state.BlackBall)
+            blackValid = blackValid && ball.Type == Ball::BallType::Black;
+    }
+
+    if (!whiteFound)
+    {
+        cout << "ERROR::TABLE::INVALID_WHITE_BALL " << state.WhiteBall << endl;
+        return false;
+    }
+
+    if (!blackValid)
+    {
+        cout << "ERROR::TABLE::INVALID_BLACK_BALL " << state.BlackBall << endl;
+        return false;
+    }
+
+    if (!std::isfinite(state.PhysicsAccumulator) || state.PhysicsAccumulator < 0.0f ||
+        state.FirstWhiteContact < -1 || state.FirstWhiteContact >= handleCount)
+    {
+        cout << "ERROR::TABLE::INVALID_PHYSICS_STATE" << endl;
+        return false;
+    }
+
+    if (state.CachedContactCount < 0 || state.CachedContactCount > TableState::MAX_CACHED_CONTACTS)
+    {
+        cout << "ERROR::TABLE::INVALID_CACHED_CONTACT_COUNT " << state.CachedContactCount << endl;
+        return false;
+    }
+
+    for (int index = 0; index < state.CachedContactCount; index++)
+    {
+        const TableState::ContactState& contact = state.CachedContacts[index];
+
+        if (contact.Handle < 0 || contact.Handle >= handleCount || contact.OtherHandle < 0 || contact.OtherHandle >= handleCount ||
+            contact.Handle == contact.OtherHandle || !std::isfinite(contact.Impulse) || contact.Impulse < 0.0f)
+        {
+            cout << "ERROR::TABLE::INVALID_CACHED_CONTACT " << index << endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+BallWorld& Table::GetWorld()
+{
+    return m_world;
+}
+
+const BallWorld& Table::GetWorld() const
+{
+    return m_world;
+}
+
+Physics& Table::GetPhysics()
+{
+    return m_physics;
+}
+
+const Physics& Table::GetPhysics() const
+{
+    return m_physics;
+}
+
+const vector<Hole*>& Table::GetHoles() const
+{
+    return m_holes;
+}
+
+unsigned int Table::GetSeed() const
+{
+    return m_seed;
+}
+
+int Table::GetVersion() const
+{
+    return m_version;
+}
+
+// Hash-ul bilelor si al regulilor; in modul determinist doua mese care au primit aceleasi lovituri au acelasi hash.
+unsigned long long Table::GetStateHash() const
+{
+    StateHash hash;
+
+    m_world.Hash(hash);
+
+    hash.Add((int)m_gameState);
+    hash.Add((int)m_currentPlayer);
+
+    for (auto& player : m_playerDetails)
+    {
+        hash.Add(player.Score);
+        hash.Add((int)player.Dead);
+        hash.Add((int)player.FinishedBalls);
+        hash.Add((int)player.AllowedBalls);
+    }
+
+    return hash.Get();
+}
+
+int Table::GetWhiteBall() const
+{
+    return m_whiteBall;
+}
+
+Table::GameState Table::GetGameState() const
+{
+    return m_gameState;
+}
+
+Table::Players Table::GetCurrentPlayer() const
+{
+    return m_currentPlayer;
+}
+
+const Table::PlayerDetails& Table::GetPlayerDetails(Players player) const
+{
+    return m_playerDetails[player];
+}
+
+// Bilele jucatorilor si cele prezente sunt masti de biti dupa handle, asa ca fiecare regula este cateva operatii pe biti.
+// Bilele bagate in gauri sunt gasite dupa flag-ul OnBoard si scoase toate odata.
+void Table::ApplyRules()
+{
+    PlayerDetails& player = m_playerDetails[m_currentPlayer];
+
+    if (m_world.GetPocketedCount() > 0)
+    {
+        for (int slot = 0; slot < m_world.GetCount(); slot++)
+        {
+            if (m_world.OnBoard(slot))
+                continue;
+
+            int handle = m_world.GetHandle(slot);
+            if (player.AllowedBalls & BallWorld::HandleBit(handle))
+                cout << "Jucatorul " << (m_currentPlayer + 1) << " a bagat in gaura bila." << endl;
+            else if (handle != m_blackBall)
+                cout << "Jucatorul " << (m_currentPlayer + 1) << " a bagat in gaura bila care apartine celuilalt jucator." << endl;
+        }
+
+        m_physics.RemovePocketed(m_world);
+    }
+
+    if (!player.FinishedBalls)
+    {
+        player.FinishedBalls = (player.AllowedBalls & m_world.GetPresentMask()) == 0;
+        if (player.FinishedBalls)
+        {
+            cout << "Jucatorul " << (m_currentPlayer + 1) << " si-a terminat bilele." << endl;
+        }
+    }
+
+    if (!(m_world.GetPresentMask() & BallWorld::HandleBit(m_blackBall)))
+    {
+        if (player.FinishedBalls)
+            m_playerDetails[(int)(m_currentPlayer + 1) % 2].Dead = true;
+        else
+            player.Dead = true;
+        
+        cout << "Jucatorul 1 a " << (m_playerDetails[Players::Player1].Dead ? "pierdut" : "castigat") << "." << endl;
+        cout << "Jucatorul 2 a " << (m_playerDetails[Players::Player2].Dead ? "pierdut" : "castigat") << "." << endl;
+
+        m_gameState = GameState::Finished;
+        return;
+    }
+
+    switch (m_gameState)
+    {
+    case GameState::Waiting:
+        {
+            if (m_world.GetAwakeCount() == 0)
+            {
+                m_gameState = GameState::Playing;
+                m_currentPlayer = (Players)(((int)m_currentPlayer + 1) % 2);
+                cout << "Este randul jucatorului " << (m_currentPlayer + 1) << "." << endl;
+            }
+        }
+        break;
+    case GameState::Playing:
+        break;
+    }
+}
+
+void Table::CreateBalls()
+{
+    vector<int> balls;
+
+    // mt19937 da aceleasi numere pe orice platforma, spre deosebire de rand()
+    mt19937 random(m_seed);
+
+    m_whiteBall = m_world.Add(vec2(0.0f, 0.0f), vec3(0.0f, 0.0f, 0.0f), true, Ball::BallType::White);
+    balls.push_back(m_whiteBall);
+
+    m_blackBall = m_world.Add(vec2(0.0f, 0.0f), vec3(0.0f, 0.0f, 0.0f), true, Ball::BallType::Black);
+    balls.push_back(m_blackBall);
+
+    balls.push_back(m_world.Add(vec2(0.0f, 0.0f), vec3(1.0f, 0.956f, 0.156f), true));
+    balls.push_back(m_world.Add(vec2(0.0f, 0.0f), vec3(0.215f, 0.333f, 0.921f), true));
+    balls.push_back(m_world.Add(vec2(0.0f, 0.0f), vec3(0.776f, 0.145f, 0.756f), true));
+    balls.push_back(m_world.Add(vec2(0.0f, 0.0f), vec3(1.0f, 0.439f, 0.062f), true));
+    balls.push_back(m_world.Add(vec2(0.0f, 0.0f), vec3(0.976f, 0.050f, 0.058f), true));
+    balls.push_back(m_world.Add(vec2(0.0f, 0.0f), vec3(0.050f, 0.811f, 0.603f), true));
+    balls.push_back(m_world.Add(vec2(0.0f, 0.0f), vec3(0.713f, 0.121f, 0.156f), true));
+
+    balls.push_back(m_world.Add(vec2(0.0f, 0.0f), vec3(0.0f, 0.654f, 0.384f), false));
+    balls.push_back(m_world.Add(vec2(0.0f, 0.0f), vec3(0.843f, 0.274f, 0.050f), false));
+    balls.push_back(m_world.Add(vec2(0.0f, 0.0f), vec3(0.807f, 0.117f, 0.780f), false));
+    balls.push_back(m_world.Add(vec2(0.0f, 0.0f), vec3(0.156f, 0.239f, 0.729f), false));
+    balls.push_back(m_world.Add(vec2(0.0f, 0.0f), vec3(0.992f, 0.823f, 0.168f), false));
+    balls.push_back(m_world.Add(vec2(0.0f, 0.0f), vec3(0.560f, 0.090f, 0.125f), false));
+    balls.push_back(m_world.Add(vec2(0.0f, 0.0f), vec3(0.933f, 0.070f, 0.078f), false));
+
+    for (int i = 1; i < balls.size(); i++)
+    {
+        int otherIndex = (int)(random() % (balls.size() - 1)) + 1;
+        swap(balls[i], balls[otherIndex]);
+    }
+
+    for (auto& ball : balls)
+    {
+        int slot = m_world.GetSlot(ball);
+        if (m_world.GetBallType(slot) == Ball::BallType::Normal)
+        {
+            if (m_world.IsSolid(slot))
+                m_playerDetails[Players::Player1].AllowedBalls |= BallWorld::HandleBit(ball);
+            else
+                m_playerDetails[Players::Player2].AllowedBalls |= BallWorld::HandleBit(ball);
+        }
+    }
+
+    int columnCount = 0;
+    int totalPerColumn = 1;
+
+    float xPosition = (Constants::GAME_WIDTH / 2.0f) + NORMAL_BALLS_OFFSET;
+
+    for (int i = 1; i < balls.size(); i++)
+    {
+        float y = Constants::GAME_HEIGHT / 2.0f;
+        float totalDist = NORMAL_BALLS_DIST_BETWEEN * (totalPerColumn - 1);
+        y = y - (totalDist / 2.0f);
+        if (totalPerColumn >= 2)
+        {
+            y = y + (totalDist) * (float(columnCount) / float(totalPerColumn - 1));
+        }
+        m_world.SetPosition(m_world.GetSlot(balls[i]), vec2(xPosition, y));
+        columnCount++;
+
+        if (columnCount >= totalPerColumn)
+        {
+            columnCount = 0;
+            totalPerColumn++;
+            xPosition += NORMAL_BALLS_DIST_BETWEEN;
+        }
+    }
+}
+
+void Table::CreateHoles()
+{
+    // gaurile de jos
+    m_holes.push_back(new Hole(vec2(HOLE_BIAS, HOLE_BIAS)));
+    m_holes.push_back(new Hole(vec2(Constants::GAME_WIDTH / 2.0f, HOLE_BIAS)));
+    m_holes.push_back(new Hole(vec2(Constants::GAME_WIDTH - HOLE_BIAS, HOLE_BIAS)));
+
+    // gaurile de sus
+    m_holes.push_back(new Hole(vec2(HOLE_BIAS, Constants::GAME_HEIGHT - HOLE_BIAS)));
+    m_holes.push_back(new Hole(vec2(Constants::GAME_WIDTH / 2.0f, Constants::GAME_HEIGHT - HOLE_BIAS)));
+    m_holes.push_back(new Hole(vec2(Constants::GAME_WIDTH - HOLE_BIAS, Constants::GAME_HEIGHT - HOLE_BIAS)));
+}
+
+Table::RayIntersection Table::GetRayIntersection(vec2 startPosition, vec2 direction, int exceptionBall) const
+{
+    vec2 endPosition = startPosition + direction * 1000.0f;
+    vec2 closestIntersect = endPosition;
+    vec2 normal = vec2(0.0f, 1.0f);
+
+    RayIntersection result;
+
+    result.BallHandle = -1;
+
+    vec2 wallIntersection;
+
+    if (VerticalIntersect(startPosition, direction, 0.0f, wallIntersection))
+    {
+        if (length(wallIntersection - startPosition) < length(closestIntersect - startPosition))
+        {
+            closestIntersect = wallIntersection;
+            normal = vec2(1.0f, 0.0f);
+        }
+    }
+
+    if (VerticalIntersect(startPosition, direction, Constants::GAME_WIDTH, wallIntersection))
+    {
+        if (length(wallIntersection - startPosition) < length(closestIntersect - startPosition))
+        {
+            closestIntersect = wallIntersection;
+            normal = vec2(-1.0f, 0.0f);
+        }
+    }
+
+    if (Horizontalntersect(startPosition, direction, 0.0f, wallIntersection))
+    {
+        if (length(wallIntersection - startPosition) < length(closestIntersect - startPosition))
+        {
+            closestIntersect = wallIntersection;
+            normal = vec2(0.0f, 1.0f);
+        }
+    }
+
+    if (Horizontalntersect(startPosition, direction, Constants::GAME_HEIGHT, wallIntersection))
+    {
+        if (length(wallIntersection - startPosition) < length(closestIntersect - startPosition))
+        {
+            closestIntersect = wallIntersection;
+            normal = vec2(0.0f, -1.0f);
+        }
+    }
+
+    // bilele sunt testate toate odata; raza se opreste la peretele gasit mai sus
+    BallKernels::Circles circles;
+    circles.CenterX = m_world.GetPositionsX();
+    circles.CenterY = m_world.GetPositionsY();
+    circles.Radius  = m_world.GetRadii();
+    circles.Count   = m_world.GetCount();
+
+    BallKernels::Ray ray;
+    ray.Origin       = startPosition;
+    ray.Direction    = direction;
+    ray.MaxDistance  = length(closestIntersect - startPosition);
+    ray.IgnoredIndex = exceptionBall != -1 ? m_world.GetSlot(exceptionBall) : -1;
+
+    BallKernels::RayHit hit = BallKernels::CastRay(ray, circles, m_physics.GetInstructionSet());
+    if (hit.Index != -1)
+    {
+        closestIntersect = startPosition + direction * hit.Distance;
+        normal = normalize(closestIntersect - m_world.GetPosition(hit.Index));
+        result.BallHandle = m_world.GetHandle(hit.Index);
+    }
+
+    result.Point = closestIntersect;
+    result.Normal = normal;
+
+    return result;
+}
+
+bool Table::VerticalIntersect(vec2 startPos, vec2 direction, float x1, vec2& intersection) const
+{
+    intersection = vec2(0.0f, 0.0f);
+    if (abs(direction.x) < 0.01f)
+    {
+        return false;
+    }
+
+    float t = (x1 - startPos.x) / direction.x;
+    float y = startPos.y + t * direction.y;
+
+    vec2 intersectPoint = vec2(x1, y);
+
+    if (dot(intersectPoint - startPos, direction) > 0.0f)
+    {
+        intersection = intersectPoint;
+        return true;
+    }
+    return false;
+}
+
+bool Table::Horizontalntersect(vec2 startPos, vec2 direction, float y1, vec2& intersection) const
+{
+    intersection = vec2(0.0f, 0.0f);
+    if (abs(direction.y) < 0.01f)
+    {
+        return false;
+    }
+
+    float t = (y1 - startPos.y) / direction.y;
+    float x = startPos.x + t * direction.x;
+
+    vec2 intersectPoint = vec2(x, y1);
+
+    if (dot(intersectPoint - startPos, direction) > 0.0f)
+    {
+        intersection = intersectPoint;
+        return true;
+    }
+
+    return false;
+}
+
+void Table::CopyHoles(const Table& other)
+{
+    for (auto& hole : other.m_holes)
+        m_holes.push_back(new Hole(*hole));
+}
+
+void Table::FreeHoles()
+{
+    for (auto& hole : m_holes)
+    {
+        if (hole)
+        {
+            delete hole;
+            hole = nullptr;
+        }
+    }
+    m_holes.clear();
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+#include <random>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Ball.h"
+#include "BallWorld.h"
+#include "Hole.h"
+#include "Physics.h"
+#include "TableState.h"
+
+// Regulile jocului si fizica mesei, fara nimic legat de fereastra sau de OpenGL.
+// O masa se poate crea, i se poate aplica o lovitura si poate fi simulata pana la oprirea bilelor.
+// Asezarea bilelor depinde doar de samanta primita, nu de rand(), ca un meci sa poata fi refacut.
+class Table
+{
+public:
+
+    enum GameState
+    {
+        Playing,
+        Waiting,
+        Finished
+    };
+
+    enum Players
+    {
+        Player1,
+        Player2
+    };
+
+    struct PlayerDetails
+    {
+    public:
+
+        PlayerDetails();
+
+    public:
+
+        int                 Score;
+        bool                Dead;
+        bool                FinishedBalls;
+
+        // masca de handle-uri (BallWorld::HandleBit) a bilelor jucatorului
+        BallWorld::BallMask AllowedBalls;
+    };
+
+    struct RayIntersection
+    {
+        glm::vec2 Point;
+        glm::vec2 Normal;
+        int       BallHandle;
+    };
+
+public:
+
+    static const float NORMAL_BALLS_OFFSET;
+    static const float NORMAL_BALLS_DIST_BETWEEN;
+    static const float HOLE_BIAS;
+    static const float HOLE_RADIUS;
+
+public:
+
+    Table(unsigned int = 0);
+    Table(const Table&);
+    ~Table();
+
+    Table&                    operator=(const Table&);
+
+    void                      Update(float);
+    bool                      ApplyShot(glm::vec2);
+    float                     UpdateUntilRest(float);
+
+    bool                      SaveState(TableState&) const;
+    bool                      RestoreState(const TableState&);
+
+    RayIntersection           GetRayIntersection(glm::vec2, glm::vec2, int = -1) const;
+
+    BallWorld&                GetWorld();
+    const BallWorld&          GetWorld()              const;
+    Physics&                  GetPhysics();
+    const Physics&            GetPhysics()            const;
+    const std::vector<Hole*>& GetHoles()              const;
+
+    unsigned int              GetSeed()               const;
+    int                       GetVersion()            const;
+    unsigned long long        GetStateHash()          const;
+    int                       GetWhiteBall()          const;
+    GameState                 GetGameState()          const;
+    Players                   GetCurrentPlayer()      const;
+    const PlayerDetails&      GetPlayerDetails(Players) const;
+
+private:
+
+    void            CreateBalls();
+    void            CreateHoles();
+    void            CopyHoles(const Table&);
+    void            FreeHoles();
+
+    void            ApplyRules();
+
+    bool            IsValidState(const TableState&) const;
+
+    bool            VerticalIntersect(glm::vec2, glm::vec2, float, glm::vec2&) const;
+    bool            Horizontalntersect(glm::vec2, glm::vec2, float, glm::vec2&) const;
+
+private:
+
+    BallWorld          m_world;
+    Physics            m_physics;
+    int                m_whiteBall;
+    int                m_blackBall;
+    std::vector<Hole*> m_holes;
+
+    // samanta cu care au fost amestecate bilele; impreuna cu loviturile descrie tot meciul (vezi ReplayLog)
+    unsigned int       m_seed;
+
+    // creste de fiecare data cand bilele sau starea jocului se pot schimba; folosit ca cheie de cache
+    int                m_version;
+
+    GameState          m_gameState;
+    Players            m_currentPlayer;
+    PlayerDetails      m_playerDetails[2];
+};
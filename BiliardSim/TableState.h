@@ -0,0 +1,75 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+#include <glm/glm.hpp>
+
+#include "Ball.h"
+
+// Toata starea unei mese care se schimba in timpul meciului, ca valoare: fara pointeri si fara memorie alocata,
+// asa ca o copie este un singur memcpy. Bilele sunt identificate prin handle (indexul din BallWorld), deci starea
+// poate fi pusa inapoi in orice masa creata cu aceleasi bile. Gaurile nu se schimba niciodata si nu sunt pastrate.
+// Se obtine cu Table::SaveState si se aplica cu Table::RestoreState.
+// Marimea este fixa: o masa cu mai mult de MAX_BALLS bile sau MAX_HANDLES handle-uri nu poate fi salvata
+// (SaveState intoarce false), asa ca starea este doar pentru mesele de joc, nu pentru simularile cu multe bile.
+struct TableState
+{
+public:
+
+    static const int MAX_BALLS           = 16;
+
+    // handle-urile bilelor scoase nu sunt refolosite, asa ca pot fi mai multe decat bilele de pe masa
+    static const int MAX_HANDLES         = 2 * MAX_BALLS;
+
+    // bilele care se ating formeaza un graf planar, deci au cel mult 3 * MAX_BALLS - 6 contacte
+    static const int MAX_CACHED_CONTACTS = 3 * MAX_BALLS;
+
+    // o bila de pe masa, in ordinea sloturilor din BallWorld
+    struct BallState
+    {
+        glm::vec2      Position;
+        glm::vec2      PreviousPosition;
+        glm::vec2      Velocity;
+        float          Radius;
+        glm::vec3      Color;
+        Ball::BallType Type;
+        int            Handle;
+        unsigned char  Flags;
+    };
+
+    // impulsul acumulat de un contact la ultimul pas, pentru pornirea la cald a Physics::Solver::SequentialImpulse
+    struct ContactState
+    {
+        int            Handle;
+        int            OtherHandle;
+        float          Impulse;
+    };
+
+    struct PlayerState
+    {
+        int            Score;
+        bool           Dead;
+        bool           FinishedBalls;
+        unsigned int   AllowedBalls;
+    };
+
+public:
+
+    BallState          Balls[MAX_BALLS];
+    int                BallCount;
+    int                HandleCount;
+
+    float              PhysicsAccumulator;
+    int                FirstWhiteContact;
+    bool               WhitePocketed;
+
+    ContactState       CachedContacts[MAX_CACHED_CONTACTS];
+    int                CachedContactCount;
+
+    unsigned int       Seed;
+    int                WhiteBall;
+    int                BlackBall;
+    int                GameState;
+    int                CurrentPlayer;
+    PlayerState        Players[2];
+};
@@ -0,0 +1,176 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+using namespace std;
+
+// Numarul de workeri include si thread-ul care apeleaza ParallelFor; 0 inseamna cate unul pe nucleu.
+ThreadPool::ThreadPool(int workerCount) :
+    m_job(nullptr),
+    m_grain(1),
+    m_generation(0),
+    m_stop(false),
+    m_pending(0)
+{
+    if (workerCount <= 0)
+        workerCount = std::max(1, (int)thread::hardware_concurrency());
+
+    for (int worker = 0; worker < workerCount; worker++)
+        m_queues.push_back(new Queue());
+
+    for (int worker = 0; worker < workerCount - 1; worker++)
+        m_threads.push_back(thread(&ThreadPool::WorkerLoop, this, worker));
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeCondition.notify_all();
+
+    for (auto& thread : m_threads)
+        thread.join();
+    m_threads.clear();
+
+    for (auto& queue : m_queues)
+    {
+        if (queue)
+        {
+            delete queue;
+            queue = nullptr;
+        }
+    }
+    m_queues.clear();
+}
+
+// Apeleaza job(index, worker) pentru fiecare index din [0, count). Un worker nu ia mai putin de grain indici
+// deodata; indicele workerului este in [0, GetWorkerCount()) si poate fi folosit pentru date temporare proprii.
+void ThreadPool::ParallelFor(int count, int grain, const Job& job)
+{
+    if (count <= 0)
+        return;
+
+    int workerCount = GetWorkerCount();
+    int callerWorker = workerCount - 1;
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+
+        m_job = &job;
+        m_grain = std::max(1, grain);
+        m_pending = count;
+
+        // Fiecare worker porneste cu o bucata egala; bucatile mari se injumatatesc pe masura ce sunt luate.
+        for (int worker = 0; worker < workerCount; worker++)
+        {
+            Range range;
+            range.Begin = (int)((long long)count * worker / workerCount);
+            range.End = (int)((long long)count * (worker + 1) / workerCount);
+            if (range.Begin == range.End)
+                continue;
+
+            lock_guard<mutex> queueLock(m_queues[worker]->Mutex);
+            m_queues[worker]->Ranges.push_back(range);
+        }
+
+        m_generation++;
+    }
+    m_wakeCondition.notify_all();
+
+    RunUntilDone(callerWorker);
+
+    unique_lock<mutex> lock(m_mutex);
+    m_doneCondition.wait(lock, [this]() { return m_pending == 0; });
+    m_job = nullptr;
+}
+
+int ThreadPool::GetWorkerCount() const
+{
+    return (int)m_queues.size();
+}
+
+void ThreadPool::WorkerLoop(int worker)
+{
+    int generation = 0;
+
+    while (true)
+    {
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_wakeCondition.wait(lock, [this, generation]() { return m_stop || m_generation != generation; });
+            if (m_stop)
+                return;
+            generation = m_generation;
+        }
+
+        RunUntilDone(worker);
+    }
+}
+
+void ThreadPool::RunUntilDone(int worker)
+{
+    while (m_pending > 0)
+    {
+        Range range;
+        if (!PopRange(worker, range) && !StealRange(worker, range))
+        {
+            this_thread::yield();
+            continue;
+        }
+
+        // Jumatatea de sus ramane in coada, ca sa poata fi furata de un worker care a terminat deja.
+        while (range.End - range.Begin > m_grain)
+        {
+            Range upper;
+            upper.Begin = range.Begin + (range.End - range.Begin) / 2;
+            upper.End = range.End;
+            range.End = upper.Begin;
+
+            lock_guard<mutex> queueLock(m_queues[worker]->Mutex);
+            m_queues[worker]->Ranges.push_back(upper);
+        }
+
+        for (int index = range.Begin; index < range.End; index++)
+            (*m_job)(index, worker);
+
+        if (m_pending.fetch_sub(range.End - range.Begin) == range.End - range.Begin)
+        {
+            lock_guard<mutex> lock(m_mutex);
+            m_doneCondition.notify_all();
+        }
+    }
+}
+
+// Workerul isi ia munca de la capatul cozii lui (cea mai recenta, deci cea mai mica)...
+bool ThreadPool::PopRange(int worker, Range& range)
+{
+    Queue* queue = m_queues[worker];
+    lock_guard<mutex> queueLock(queue->Mutex);
+
+    if (queue->Ranges.empty())
+        return false;
+
+    range = queue->Ranges.back();
+    queue->Ranges.pop_back();
+    return true;
+}
+
+// ...si fura de la inceputul cozilor celorlalti, unde raman bucatile cele mai mari.
+bool ThreadPool::StealRange(int worker, Range& range)
+{
+    for (int offset = 1; offset < GetWorkerCount(); offset++)
+    {
+        Queue* queue = m_queues[(worker + offset) % GetWorkerCount()];
+        lock_guard<mutex> queueLock(queue->Mutex);
+
+        if (queue->Ranges.empty())
+            continue;
+
+        range = queue->Ranges.front();
+        queue->Ranges.pop_front();
+        return true;
+    }
+    return false;
+}
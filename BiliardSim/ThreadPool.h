@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool de thread-uri cu work stealing. Fiecare worker are coada lui de intervale de indici; cand o goleste,
+// fura intervale de la ceilalti. Thread-ul care apeleaza ParallelFor lucreaza si el, ca ultimul worker.
+// ParallelFor nu se poate apela din mai multe thread-uri deodata si nici din interiorul unui job.
+class ThreadPool
+{
+public:
+
+    typedef std::function<void(int, int)> Job;
+
+public:
+
+    ThreadPool(int = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void ParallelFor(int, int, const Job&);
+
+    int  GetWorkerCount() const;
+
+private:
+
+    struct Range
+    {
+        int Begin;
+        int End;
+    };
+
+    struct Queue
+    {
+        std::mutex        Mutex;
+        std::deque<Range> Ranges;
+    };
+
+private:
+
+    void WorkerLoop(int);
+    void RunUntilDone(int);
+    bool PopRange(int, Range&);
+    bool StealRange(int, Range&);
+
+private:
+
+    std::vector<std::thread> m_threads;
+    std::vector<Queue*>      m_queues;
+
+    std::mutex               m_mutex;
+    std::condition_variable  m_wakeCondition;
+    std::condition_variable  m_doneCondition;
+
+    const Job*               m_job;
+    int                      m_grain;
+    int                      m_generation;
+    bool                     m_stop;
+    std::atomic<int>         m_pending;
+};
@@ -0,0 +1,117 @@
+#include "TrajectoryPredictor.h"
+
+using namespace std;
+using namespace glm;
+
+TrajectoryPredictor::TrajectoryPredictor() :
+    m_valid(false),
+    m_version(-1),
+    m_whitePosition(0.0f, 0.0f),
+    m_velocity(0.0f, 0.0f),
+    m_pathCount(0),
+    m_pointCount(0)
+{
+}
+
+// Intoarce true daca drumurile au fost recalculate, false daca rezultatul anterior era inca valabil.
+bool TrajectoryPredictor::Predict(const Table& table, vec2 velocity)
+{
+    vec2 whitePosition = table.GetWorld().GetPosition(table.GetWorld().GetSlot(table.GetWhiteBall()));
+
+    if (m_valid && m_version == table.GetVersion() && m_whitePosition == whitePosition && m_velocity == velocity)
+        return false;
+
+    Simulate(table, velocity);
+
+    m_valid = true;
+    m_version = table.GetVersion();
+    m_whitePosition = whitePosition;
+    m_velocity = velocity;
+
+    return true;
+}
+
+int TrajectoryPredictor::GetPathCount() const
+{
+    return m_pathCount;
+}
+
+const TrajectoryPredictor::Path& TrajectoryPredictor::GetPath(int index) const
+{
+    return m_paths[index];
+}
+
+int TrajectoryPredictor::GetPointCount() const
+{
+    return m_pointCount;
+}
+
+void TrajectoryPredictor::Simulate(const Table& table, vec2 velocity)
+{
+    const BallWorld& source = table.GetWorld();
+
+    m_world = source;
+    m_world.GetBall(table.GetWhiteBall()).SetVelocity(velocity);
+
+    // EventSolver da exact punctele de impact, indiferent de solverul folosit de masa; pasul nu conteaza pentru el
+    m_physics = table.GetPhysics();
+    m_physics.SetSolver(Physics::Solver::EventDriven);
+    m_physics.SetContactRecording(true);
+
+    m_physics.ResetShotEvents();
+    m_physics.UpdateUntilRest(0.0f, m_world, table.GetHoles());
+
+    m_pathCount = 0;
+    m_pathOfHandle.assign(source.GetHandleCount(), -1);
+
+    // drumul bilei albe este mereu primul, chiar daca nu atinge nimic
+    GetPathOf(table.GetWhiteBall(), source.GetPosition(source.GetSlot(table.GetWhiteBall())));
+
+    for (auto& contact : m_physics.GetShotEvents().Contacts)
+    {
+        Path& path = GetPathOf(contact.Handle, source.GetPosition(source.GetSlot(contact.Handle)));
+        if (path.Pocketed || (int)path.Points.size() > MAX_BOUNCES)
+            continue;
+
+        // bilele din triunghi se ating de la inceput, asa ca primul impact poate fi chiar pozitia de start
+        if (contact.Position != path.Points.back())
+            path.Points.push_back(contact.Position);
+
+        path.Pocketed = contact.Type == ShotEvents::ContactType::Hole;
+    }
+
+    m_pointCount = 0;
+    for (int index = 0; index < m_pathCount; index++)
+    {
+        Path& path = m_paths[index];
+
+        // pozitia unde se opreste bila, daca drumul nu s-a terminat intr-o gaura sau dupa MAX_BOUNCES impacturi
+        if (!path.Pocketed && (int)path.Points.size() <= MAX_BOUNCES)
+        {
+            vec2 restPosition = m_world.GetPosition(m_world.GetSlot(path.Handle));
+            if (restPosition != path.Points.back())
+                path.Points.push_back(restPosition);
+        }
+
+        m_pointCount += (int)path.Points.size();
+    }
+}
+
+TrajectoryPredictor::Path& TrajectoryPredictor::GetPathOf(int handle, vec2 startPosition)
+{
+    int& index = m_pathOfHandle[handle];
+    if (index != -1)
+        return m_paths[index];
+
+    index = m_pathCount++;
+    if (index == (int)m_paths.size())
+        m_paths.push_back(Path());
+
+    Path& path = m_paths[index];
+    path.Handle = handle;
+    path.Points.clear();
+    path.Points.push_back(startPosition);
+    path.Pocketed = false;
+
+    return path;
+}
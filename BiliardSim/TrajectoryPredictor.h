@@ -0,0 +1,61 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "BallWorld.h"
+#include "Physics.h"
+#include "Table.h"
+
+// Prezice drumul bilelor pentru o lovitura: simuleaza lovitura pe o copie a mesei cu EventSolver
+// (aceeasi frecare si aceeasi restitutie ca jocul) si transforma impacturile in linii frante, cate una pe bila miscata.
+// Rezultatul este pastrat si refolosit cat timp pozitia bilei albe, lovitura si Table::GetVersion() raman aceleasi.
+class TrajectoryPredictor
+{
+public:
+
+    struct Path
+    {
+        int                    Handle;
+        std::vector<glm::vec2> Points;
+        bool                   Pocketed;
+    };
+
+public:
+
+    // cate impacturi sunt urmarite pe fiecare drum; dupa ele drumul se opreste
+    static const int MAX_BOUNCES = 8;
+
+public:
+
+    TrajectoryPredictor();
+
+    bool  Predict(const Table&, glm::vec2);
+
+    int   GetPathCount()  const;
+    const Path& GetPath(int) const;
+    int   GetPointCount() const;
+
+private:
+
+    void  Simulate(const Table&, glm::vec2);
+    Path& GetPathOf(int, glm::vec2);
+
+private:
+
+    BallWorld         m_world;
+    Physics           m_physics;
+
+    bool              m_valid;
+    int               m_version;
+    glm::vec2         m_whitePosition;
+    glm::vec2         m_velocity;
+
+    // drumurile sunt refolosite intre predictii, ca sa nu se aloce memorie la fiecare miscare a mouse-ului
+    std::vector<Path> m_paths;
+    int               m_pathCount;
+    int               m_pointCount;
+    std::vector<int>  m_pathOfHandle;
+};
@@ -0,0 +1,118 @@
+#include "BroadphaseBench.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Ball.h"
+#include "BallWorld.h"
+#include "Constants.h"
+#include "Hole.h"
+#include "Physics.h"
+
+using namespace std;
+using namespace glm;
+
+namespace
+{
+    const int   BALL_COUNTS[]   = { 16, 64, 256, 1024, 4096, 16384, 65536, 100000 };
+
+    // cautarea pe toate perechile creste cu patratul numarului de bile; peste atatea bile este sarita
+    const int   MAX_BRUTE_FORCE = 16384;
+    const int   STEP_COUNT      = 100;
+    const float MAX_SPEED       = 300.0f;
+
+    // cu 256 de bile de raza BALL_RADIUS masa este acoperita cam o treime
+    const int   REFERENCE_COUNT = 256;
+
+    // Bilele sunt puse pe o grila cu mici abateri, ca sa nu se suprapuna la inceput, si pornesc in directii la intamplare.
+    // Viteza scade odata cu raza, ca bilele sa treaca intr-un pas aceeasi parte din raza lor (si CCD-ul sa nu conteze).
+    BallWorld CreateWorld(int count, float radius)
+    {
+        mt19937 random(count);
+        uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        int columns = (int)ceil(sqrt(count * (float)Constants::GAME_WIDTH / Constants::GAME_HEIGHT));
+        int rows = (count + columns - 1) / columns;
+        float cellWidth = (float)Constants::GAME_WIDTH / columns;
+        float cellHeight = (float)Constants::GAME_HEIGHT / rows;
+
+        BallWorld world;
+        for (int index = 0; index < count; index++)
+        {
+            float x = (index % columns + 0.5f) * cellWidth + (unit(random) - 0.5f) * glm::max(cellWidth - 2.0f * radius, 0.0f);
+            float y = (index / columns + 0.5f) * cellHeight + (unit(random) - 0.5f) * glm::max(cellHeight - 2.0f * radius, 0.0f);
+
+            int slot = world.Add(vec2(x, y), vec3(1.0f), true, Ball::BallType::Normal, radius);
+
+            float angle = unit(random) * 6.2831853f;
+            world.SetVelocity(slot, vec2(cos(angle), sin(angle)) * unit(random) * MAX_SPEED * radius / Ball::BALL_RADIUS);
+        }
+
+        return world;
+    }
+
+    int CountTouchingPairs(const BallWorld& world)
+    {
+        const float* positionX = world.GetPositionsX();
+        const float* positionY = world.GetPositionsY();
+        const float* radii = world.GetRadii();
+
+        int touching = 0;
+        for (int slot = 0; slot < world.GetCount(); slot++)
+        {
+            for (int other = slot + 1; other < world.GetCount(); other++)
+            {
+                float dx = positionX[slot] - positionX[other];
+                float dy = positionY[slot] - positionY[other];
+                float distance = radii[slot] + radii[other];
+
+                touching += dx * dx + dy * dy < distance * distance;
+            }
+        }
+
+        return touching;
+    }
+}
+
+void RunBroadphaseBench()
+{
+    printf("Broadphase: pas de fizica la densitate constanta, %d pasi de 1/120 s\n", STEP_COUNT);
+
+    vector<Hole*> holes;
+
+    for (int count : BALL_COUNTS)
+    {
+        float radius = Ball::BALL_RADIUS * sqrt((float)REFERENCE_COUNT / count);
+        if (count < REFERENCE_COUNT)
+            radius = Ball::BALL_RADIUS;
+
+        BallWorld world = CreateWorld(count, radius);
+
+        Physics physics;
+        physics.SetSubstepFraction(0.0f);
+
+        auto start = chrono::steady_clock::now();
+        for (int step = 0; step < STEP_COUNT; step++)
+            physics.Update(1.0f / 120.0f, world, holes);
+        double stepSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count() / STEP_COUNT;
+
+        printf("  %6d bile (raza %5.2f): %9.3f ms pe pas, %6.3f us pe bila",
+               count, radius, stepSeconds * 1000.0, stepSeconds * 1e6 / count);
+
+        if (count > MAX_BRUTE_FORCE)
+        {
+            printf("\n");
+            continue;
+        }
+
+        start = chrono::steady_clock::now();
+        int touching = CountTouchingPairs(world);
+        double bruteSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        printf("; toate perechile: %9.3f ms (%d in contact)\n", bruteSeconds * 1000.0, touching);
+    }
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+// Cat costa un pas de fizica (Physics::Update, cu arborele pentru perechile de bile) cand creste numarul de bile,
+// de la 16 la 100000, la densitate constanta: razele scad ca bilele sa acopere mereu aceeasi parte din masa.
+// Pentru comparatie, pana la MAX_BRUTE_FORCE bile, acelasi test de contact facut pe toate perechile de bile.
+void RunBroadphaseBench();
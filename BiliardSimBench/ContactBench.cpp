@@ -0,0 +1,272 @@
+#include "ContactBench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Ball.h"
+#include "BallWorld.h"
+#include "Hole.h"
+#include "Physics.h"
+#include "StateHash.h"
+#include "Table.h"
+#include "ThreadPool.h"
+
+using namespace std;
+using namespace glm;
+
+namespace
+{
+    const float FRAME_TIME       = 1.0f / 60.0f;
+    const int   MAX_FRAMES       = 100000;
+    const int   SHOT_SEEDS       = 20;
+
+    // varful triunghiului strans si pozitia albei in fata lui, pe axa de simetrie a mesei
+    const float RACK_APEX_X      = 740.0f;
+    const float RACK_APEX_Y      = 360.0f;
+    const float WHITE_X          = 698.0f;
+
+    const int   DENSE_COLUMNS    = 400;
+    const int   DENSE_ROWS       = 250;
+    const float DENSE_MAX_SPEED  = 20.0f;
+    const int   DENSE_STEPS      = 5;
+    const int   DENSE_THREADS[]  = { 0, 1, 4 };
+
+    struct Config
+    {
+        const char*     Name;
+        Physics::Solver Solver;
+        int             Iterations;
+    };
+
+    const Config CONFIGS[] =
+    {
+        { "TimeStepped",          Physics::Solver::TimeStepped,       0 },
+        { "SequentialImpulse 8",  Physics::Solver::SequentialImpulse, 8 },
+        { "SequentialImpulse 16", Physics::Solver::SequentialImpulse, 16 }
+    };
+
+    struct ShotTimes
+    {
+        int    Shots;
+        double RestSeconds;
+        double CpuSeconds;
+    };
+
+    void Setup(Table& table, const Config& config)
+    {
+        table.GetPhysics().SetDeterministic(true);
+        table.GetPhysics().SetSolver(config.Solver);
+        if (config.Iterations > 0)
+            table.GetPhysics().SetContactIterations(config.Iterations);
+    }
+
+    // Bilele colorate lipite intr-un triunghi cu varful in (RACK_APEX_X, RACK_APEX_Y), simetric fata de mijlocul mesei.
+    void TightenRack(Table& table)
+    {
+        BallWorld& world = table.GetWorld();
+
+        vector<int> slots;
+        for (int slot = 0; slot < world.GetCount(); slot++)
+            if (world.GetHandle(slot) != table.GetWhiteBall())
+                slots.push_back(slot);
+
+        sort(slots.begin(), slots.end(), [&world](int first, int second)
+        {
+            vec2 firstPosition = world.GetPosition(first);
+            vec2 secondPosition = world.GetPosition(second);
+            return firstPosition.x < secondPosition.x || (firstPosition.x == secondPosition.x && firstPosition.y < secondPosition.y);
+        });
+
+        int column = 0;
+        int perColumn = 1;
+        float x = RACK_APEX_X;
+
+        for (int index = 0; index < (int)slots.size(); index++)
+        {
+            world.SetPosition(slots[index], vec2(x, RACK_APEX_Y - Ball::BALL_RADIUS * (perColumn - 1) + 2.0f * Ball::BALL_RADIUS * column));
+
+            if (++column >= perColumn)
+            {
+                column = 0;
+                perColumn++;
+                x += Ball::BALL_RADIUS * sqrt(3.0f);
+            }
+        }
+    }
+
+    void Shoot(Table& table, vec2 velocity, ShotTimes& times)
+    {
+        table.ApplyShot(velocity);
+
+        auto start = chrono::steady_clock::now();
+        int frames = 0;
+        while (table.GetGameState() == Table::GameState::Waiting && frames < MAX_FRAMES)
+        {
+            table.Update(FRAME_TIME);
+            frames++;
+        }
+
+        times.Shots++;
+        times.RestSeconds += frames * FRAME_TIME;
+        times.CpuSeconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+
+    // Cea mai mare distanta de la oglindirea unei bile fata de mijlocul mesei la cea mai apropiata bila.
+    float GetAsymmetry(const BallWorld& world)
+    {
+        float asymmetry = 0.0f;
+
+        for (int slot = 0; slot < world.GetCount(); slot++)
+        {
+            vec2 mirrored = world.GetPosition(slot);
+            mirrored.y = 2.0f * RACK_APEX_Y - mirrored.y;
+
+            float closest = 1e9f;
+            for (int other = 0; other < world.GetCount(); other++)
+                closest = std::min(closest, length(world.GetPosition(other) - mirrored));
+
+            asymmetry = std::max(asymmetry, closest);
+        }
+
+        return asymmetry;
+    }
+
+    void PrintShots(const ShotTimes& times)
+    {
+        printf("oprire dupa %6.2f s, %7.3f ms CPU pe lovitura", times.RestSeconds / times.Shots, times.CpuSeconds / times.Shots * 1e3);
+    }
+
+    void RunGameShots(const Config& config)
+    {
+        ShotTimes breaks = { 0, 0.0, 0.0 };
+        ShotTimes randomShots = { 0, 0.0, 0.0 };
+
+        for (unsigned int seed = 1; seed <= SHOT_SEEDS; seed++)
+        {
+            mt19937 random(seed);
+            uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+            Table breakTable(seed);
+            Setup(breakTable, config);
+            Shoot(breakTable, vec2(1000.0f + unit(random) * 200.0f, (unit(random) - 0.5f) * 20.0f), breaks);
+
+            Table randomTable(seed);
+            Setup(randomTable, config);
+            float angle = unit(random) * 6.2831853f;
+            Shoot(randomTable, vec2(cos(angle), sin(angle)) * (200.0f + unit(random) * 500.0f), randomShots);
+        }
+
+        printf("  %-20s ", config.Name);
+        PrintShots(breaks);
+        printf(" | ");
+        PrintShots(randomShots);
+        printf("\n");
+    }
+
+    void RunTightRack(const Config& config)
+    {
+        ShotTimes times = { 0, 0.0, 0.0 };
+        double asymmetry = 0.0;
+
+        for (float speed = 10.0f; speed <= 1000.0f; speed *= 1.25f)
+        {
+            Table table(1);
+            TightenRack(table);
+            Setup(table, config);
+
+            BallWorld& world = table.GetWorld();
+            world.SetPosition(world.GetSlot(table.GetWhiteBall()), vec2(WHITE_X, RACK_APEX_Y));
+
+            Shoot(table, vec2(speed, 0.0f), times);
+            asymmetry += GetAsymmetry(world);
+        }
+
+        printf("  %-20s ", config.Name);
+        PrintShots(times);
+        printf(", asimetrie %7.2f\n", asymmetry / times.Shots);
+    }
+
+    void RunDense(const Config& config)
+    {
+        unsigned long long firstHash = 0;
+        bool identical = true;
+
+        for (int index = 0; index < (int)(sizeof(DENSE_THREADS) / sizeof(DENSE_THREADS[0])); index++)
+        {
+            int threads = DENSE_THREADS[index];
+
+            mt19937 random(3);
+            uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+            float cellWidth = 1270.0f / DENSE_COLUMNS;
+            float cellHeight = 710.0f / DENSE_ROWS;
+
+            BallWorld world;
+            for (int row = 0; row < DENSE_ROWS; row++)
+            {
+                for (int column = 0; column < DENSE_COLUMNS; column++)
+                {
+                    vec2 position(5.0f + cellWidth * (column + 0.5f) + (unit(random) - 0.5f) * 0.4f, 5.0f + cellHeight * (row + 0.5f) + (unit(random) - 0.5f) * 0.4f);
+                    int handle = world.Add(position, vec3(1.0f), true, Ball::BallType::Normal, 1.2f + unit(random) * 0.3f);
+
+                    float velocityX = (unit(random) - 0.5f) * 2.0f * DENSE_MAX_SPEED;
+                    float velocityY = (unit(random) - 0.5f) * 2.0f * DENSE_MAX_SPEED;
+                    world.SetVelocity(world.GetSlot(handle), vec2(velocityX, velocityY));
+                }
+            }
+
+            ThreadPool* pool = threads > 0 ? new ThreadPool(threads) : nullptr;
+
+            Physics physics;
+            physics.SetDeterministic(true);
+            physics.SetSolver(config.Solver);
+            if (config.Iterations > 0)
+                physics.SetContactIterations(config.Iterations);
+            physics.SetThreadPool(pool);
+
+            vector<Hole*> holes;
+
+            // primul pas aloca memoria pentru perechi si loturi
+            physics.Update(Physics::DETERMINISTIC_STEP, world, holes);
+
+            auto start = chrono::steady_clock::now();
+            for (int step = 0; step < DENSE_STEPS; step++)
+                physics.Update(Physics::DETERMINISTIC_STEP, world, holes);
+            double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+            StateHash hash;
+            world.Hash(hash);
+
+            if (index == 0)
+                firstHash = hash.Get();
+            identical = identical && hash.Get() == firstHash;
+
+            printf("  %-20s %d fire %9.2f ms pe pas, hash %016llx\n", config.Name, threads, seconds / DENSE_STEPS * 1e3, (unsigned long long)hash.Get());
+
+            delete pool;
+        }
+
+        if (!identical)
+            printf("ERROR::CONTACT_BENCH::HASH_DEPENDS_ON_THREADS %s\n", config.Name);
+    }
+}
+
+void RunContactBench()
+{
+    printf("Contacte: %d mese, spargere | lovitura la intamplare, cadre de 1/60 s\n", SHOT_SEEDS);
+    for (const Config& config : CONFIGS)
+        RunGameShots(config);
+
+    printf("Contacte: triunghi strans, lovituri drepte cu viteze de la 10 la 1000\n");
+    for (const Config& config : CONFIGS)
+        RunTightRack(config);
+
+    printf("Contacte: %d bile aproape lipite, %d pasi\n", DENSE_COLUMNS * DENSE_ROWS, DENSE_STEPS);
+    for (int index = 0; index < 2; index++)
+        RunDense(CONFIGS[index]);
+}
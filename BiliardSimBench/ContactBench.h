@@ -0,0 +1,8 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+// TimeStepped fata de SequentialImpulse: timpul pana la oprire si costul pe lovitura la spargeri, lovituri la intamplare
+// si lovituri drepte in triunghiul strans (cu asimetria asezarii finale), apoi un pas pe 100000 de bile aproape lipite,
+// cu si fara ThreadPool, care trebuie sa dea aceeasi stare.
+void RunContactBench();
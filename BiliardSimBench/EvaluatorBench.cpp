@@ -0,0 +1,62 @@
+#include "EvaluatorBench.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "ShotEvaluator.h"
+#include "Table.h"
+
+using namespace std;
+using namespace glm;
+
+namespace
+{
+    const int SHOT_COUNT = 2000;
+
+    const char* SOLVER_NAMES[] = { "TimeStepped", "EventDriven", "SequentialImpulse" };
+}
+
+void RunEvaluatorBench()
+{
+    // lovituri in toate directiile, cu 7 puteri diferite
+    vector<vec2> shots;
+    for (int shot = 0; shot < SHOT_COUNT; shot++)
+    {
+        float angle = shot * 6.2831853f / SHOT_COUNT;
+        shots.push_back(vec2(cos(angle), sin(angle)) * (200.0f + (shot % 7) * 100.0f));
+    }
+
+    int coreCount = std::max(1, (int)thread::hardware_concurrency());
+
+    vector<int> threadCounts;
+    for (int threads = 1; threads < coreCount; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(coreCount);
+
+    printf("ShotEvaluator: %d lovituri de la inceputul meciului, %d nuclee\n", SHOT_COUNT, coreCount);
+
+    for (int solver = 0; solver < 3; solver++)
+    {
+        Table table(1);
+        table.GetPhysics().SetDeterministic(true);
+        table.GetPhysics().SetSolver((Physics::Solver)solver);
+
+        for (int threads : threadCounts)
+        {
+            ShotEvaluator evaluator(threads);
+            vector<ShotEvaluator::ShotOutcome> outcomes;
+
+            // primul apel incalzeste workerii si memoria lor, doar al doilea este masurat
+            evaluator.Evaluate(table, shots, outcomes);
+            evaluator.Evaluate(table, shots, outcomes);
+
+            const ShotEvaluator::Statistics& statistics = evaluator.GetStatistics();
+            printf("  %-17s %2d thread-uri: %7.3f s, %8.0f lovituri/s, %7.0f lovituri/s pe nucleu\n", SOLVER_NAMES[solver],
+                   statistics.Threads, statistics.Seconds, statistics.Shots / statistics.Seconds, statistics.ShotsPerSecondPerThread);
+        }
+    }
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+// Loviturile pe secunda ale lui ShotEvaluator pe fiecare nucleu, cu fiecare solver, pornind de la triunghiul de
+// la inceput, pe o masa in modul determinist ca in joc. Se ruleaza cu 1, 2, 4, ... thread-uri, pana la cate nuclee are masina.
+void RunEvaluatorBench();
@@ -0,0 +1,138 @@
+#include "PrecisionBench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+#include "Ball.h"
+#include "BallPhysics.h"
+#include "Constants.h"
+#include "Fixed.h"
+
+using namespace std;
+
+namespace
+{
+    const int   STEP_COUNT   = 1500;
+    const int   REPEATS      = 500;
+    const float STEP         = 1.0f / 120.0f;
+
+    double ToDouble(float value)  { return (double)value; }
+    double ToDouble(double value) { return value; }
+    double ToDouble(Fixed value)  { return value.ToDouble(); }
+
+    // Aceleasi verificari ca in Physics, dar pentru doua bile si fara buzunare.
+    template <typename T>
+    class TwoBalls
+    {
+    public:
+
+        typedef BallPhysics<T>            Physics;
+        typedef typename Physics::Vector Vector;
+
+    public:
+
+        TwoBalls()
+        {
+            T radius = T(Ball::BALL_RADIUS);
+
+            m_balls[0] = { Vector(T(200.0f), T(300.0f)), Vector(T(600.0f), T(350.0f)), radius, false };
+            m_balls[1] = { Vector(T(600.0f), T(250.0f)), Vector(T(-300.0f), T(200.0f)), radius, false };
+        }
+
+        void Step(T deltaTime)
+        {
+            T radius = T(Ball::BALL_RADIUS);
+            T width = T(Constants::GAME_WIDTH);
+            T height = T(Constants::GAME_HEIGHT);
+
+            Vector distance = m_balls[0].Position - m_balls[1].Position;
+            if (Physics::Dot(distance, distance) < T(4.0f) * radius * radius)
+                Physics::ResolveColission(m_balls[0], m_balls[1]);
+
+            for (int index = 0; index < 2; index++)
+            {
+                typename Physics::State& ball = m_balls[index];
+
+                if (ball.Position.x - radius < T(0.0f))
+                    Physics::ResolveCushion(ball, Vector(T(1.0f), T(0.0f)), radius - ball.Position.x);
+                if (ball.Position.x + radius > width)
+                    Physics::ResolveCushion(ball, Vector(T(-1.0f), T(0.0f)), ball.Position.x + radius - width);
+                if (ball.Position.y - radius < T(0.0f))
+                    Physics::ResolveCushion(ball, Vector(T(0.0f), T(1.0f)), radius - ball.Position.y);
+                if (ball.Position.y + radius > height)
+                    Physics::ResolveCushion(ball, Vector(T(0.0f), T(-1.0f)), ball.Position.y + radius - height);
+
+                Physics::Update(deltaTime, ball);
+            }
+        }
+
+        const typename Physics::State& GetBall(int index) const { return m_balls[index]; }
+
+    private:
+
+        typename Physics::State m_balls[2];
+    };
+
+    template <typename T, typename U>
+    double GetDistance(const TwoBalls<T>& first, const TwoBalls<U>& second, int index)
+    {
+        double x = ToDouble(first.GetBall(index).Position.x) - ToDouble(second.GetBall(index).Position.x);
+        double y = ToDouble(first.GetBall(index).Position.y) - ToDouble(second.GetBall(index).Position.y);
+
+        return sqrt(x * x + y * y);
+    }
+
+    template <typename T>
+    void RunThroughput(const char* name)
+    {
+        double checksum = 0.0;
+
+        auto start = chrono::steady_clock::now();
+        for (int repeat = 0; repeat < REPEATS; repeat++)
+        {
+            TwoBalls<T> balls;
+            for (int step = 0; step < STEP_COUNT; step++)
+                balls.Step(T(STEP));
+
+            checksum += ToDouble(balls.GetBall(0).Position.x);
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        // checksum-ul tine compilatorul departe de bucla
+        printf("  %-7s %8.2f milioane de pasi de bila pe secunda (control %.3f)\n", name, 2.0 * REPEATS * STEP_COUNT / seconds / 1e6, checksum / REPEATS);
+    }
+}
+
+void RunPrecisionBench()
+{
+    TwoBalls<float> single;
+    TwoBalls<double> reference;
+    TwoBalls<Fixed> fixed;
+
+    double floatDrift = 0.0;
+    double fixedDrift = 0.0;
+
+    for (int step = 0; step < STEP_COUNT; step++)
+    {
+        single.Step(STEP);
+        reference.Step((double)STEP);
+        fixed.Step(Fixed(STEP));
+
+        for (int index = 0; index < 2; index++)
+        {
+            floatDrift = std::max(floatDrift, GetDistance(single, reference, index));
+            fixedDrift = std::max(fixedDrift, GetDistance(fixed, reference, index));
+        }
+    }
+
+    printf("Precizie: doua bile, %d pasi de 1/120 s, abaterea maxima fata de double\n", STEP_COUNT);
+    printf("  float   %.6g\n", floatDrift);
+    printf("  Fixed   %.6g\n", fixedDrift);
+
+    printf("Precizie: viteza pe tip numeric\n");
+    RunThroughput<float>("float");
+    RunThroughput<double>("double");
+    RunThroughput<Fixed>("Fixed");
+}
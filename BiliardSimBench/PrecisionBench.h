@@ -0,0 +1,7 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+// Doua bile simulate cu BallPhysics<float>, <double> si <Fixed> pe o masa goala: cat se departeaza float si Fixed
+// de double dupa 1500 de pasi si cati pasi de bila pe secunda face fiecare tip.
+void RunPrecisionBench();
@@ -0,0 +1,124 @@
+#include "QuadtreeBench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Ball.h"
+#include "BallWorld.h"
+#include "LooseQuadtree.h"
+
+using namespace std;
+using namespace glm;
+
+namespace
+{
+    const int   BALL_COUNTS[]    = { 1000, 10000, 40000 };
+    const int   MAX_CHECKED      = 10000;
+    const int   STEP_COUNT       = 20;
+    const float MIN_RADIUS       = 1.0f;
+    const float MAX_RADIUS       = 6.0f;
+    const float MAX_MOVE         = 2.0f;
+
+    // masa de 1280 x 720 pentru 1000 de bile, marita ca densitatea sa ramana aceeasi
+    const float BASE_WIDTH       = 1280.0f;
+    const float BASE_HEIGHT      = 720.0f;
+    const int   BASE_COUNT       = 1000;
+
+    set<pair<int, int>> GetTouchingPairs(const BallWorld& world)
+    {
+        set<pair<int, int>> pairs;
+
+        int count = world.GetCount();
+        for (int first = 0; first < count; first++)
+        {
+            for (int second = first + 1; second < count; second++)
+            {
+                vec2 distance = world.GetPosition(first) - world.GetPosition(second);
+                float radius = world.GetRadius(first) + world.GetRadius(second);
+
+                if (dot(distance, distance) <= radius * radius)
+                    pairs.insert(make_pair(std::min(world.GetHandle(first), world.GetHandle(second)), std::max(world.GetHandle(first), world.GetHandle(second))));
+            }
+        }
+
+        return pairs;
+    }
+
+    void RunBallCount(int count)
+    {
+        mt19937 random(count);
+        uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        float scale = sqrt((float)count / BASE_COUNT);
+        float width = BASE_WIDTH * scale;
+        float height = BASE_HEIGHT * scale;
+
+        BallWorld world;
+        for (int index = 0; index < count; index++)
+            world.Add(vec2(unit(random) * width, unit(random) * height), vec3(1.0f), true, Ball::BallType::Normal, MIN_RADIUS + unit(random) * (MAX_RADIUS - MIN_RADIUS));
+
+        LooseQuadtree tree(width, height);
+
+        auto start = chrono::steady_clock::now();
+        tree.Update(world);
+        double build = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        vector<pair<int, int>> candidates;
+        double seconds = 0.0;
+
+        for (int step = 0; step < STEP_COUNT; step++)
+        {
+            for (int slot = 0; slot < count; slot++)
+            {
+                vec2 position = world.GetPosition(slot);
+                world.SetPosition(slot, vec2(position.x + (unit(random) - 0.5f) * MAX_MOVE, position.y + (unit(random) - 0.5f) * MAX_MOVE));
+            }
+
+            start = chrono::steady_clock::now();
+            candidates.clear();
+            tree.Update(world);
+            tree.FindPairs(candidates);
+            seconds += chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        }
+
+        printf("  %6d bile: prima inserare %8.3f ms, Update + FindPairs %8.3f ms, %7d candidati",
+               count, build * 1e3, seconds / STEP_COUNT * 1e3, (int)candidates.size());
+
+        if (count > MAX_CHECKED)
+        {
+            printf("\n");
+            return;
+        }
+
+        set<pair<int, int>> found;
+        for (int index = 0; index < (int)candidates.size(); index++)
+            found.insert(make_pair(std::min(candidates[index].first, candidates[index].second), std::max(candidates[index].first, candidates[index].second)));
+
+        set<pair<int, int>> touching = GetTouchingPairs(world);
+
+        int missing = 0;
+        for (const pair<int, int>& touchingPair : touching)
+            if (found.find(touchingPair) == found.end())
+                missing++;
+
+        printf(", %6d perechi in contact, %d lipsa\n", (int)touching.size(), missing);
+
+        if (missing > 0)
+            printf("ERROR::QUADTREE_BENCH::MISSING_PAIRS %d\n", missing);
+    }
+}
+
+void RunQuadtreeBench()
+{
+    printf("LooseQuadtree: raze intre %.0f si %.0f, aceeasi densitate, %d pasi\n", MIN_RADIUS, MAX_RADIUS, STEP_COUNT);
+
+    for (int count : BALL_COUNTS)
+        RunBallCount(count);
+}
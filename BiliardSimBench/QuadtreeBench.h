@@ -0,0 +1,7 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+// LooseQuadtree::Update + FindPairs pe 1000, 10000 si 40000 de bile cu raze intre 1 si 6 care se misca putin
+// intre pasi. Pana la 10000 de bile perechile sunt verificate cu cautarea tuturor perechilor.
+void RunQuadtreeBench();
@@ -0,0 +1,97 @@
+#include "RayBench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "BallKernels.h"
+
+using namespace std;
+using namespace glm;
+
+namespace
+{
+    const int   CIRCLE_COUNTS[]  = { 16, 1000, 100000 };
+    const int   MAX_RAY_WORK     = 25000000;
+    const int   MAX_RAY_COUNT    = 4096;
+    const float SPACING          = 60.0f;
+
+    const char* INSTRUCTION_SET_NAMES[] = { "Scalar", "SSE", "AVX2", "AVX512" };
+
+    bool SameHits(const vector<BallKernels::RayHit>& first, const vector<BallKernels::RayHit>& second)
+    {
+        for (int index = 0; index < (int)first.size(); index++)
+            if (first[index].Index != second[index].Index || memcmp(&first[index].Distance, &second[index].Distance, sizeof(float)) != 0)
+                return false;
+
+        return true;
+    }
+
+    void RunCircleCount(int count, mt19937& random)
+    {
+        uniform_real_distribution<float> unit(0.0f, 1.0f);
+        float side = sqrt((float)count) * SPACING;
+
+        vector<float> centerX(count), centerY(count), radius(count);
+        for (int index = 0; index < count; index++)
+        {
+            centerX[index] = unit(random) * side;
+            centerY[index] = unit(random) * side;
+            radius[index] = 4.0f + unit(random) * 12.0f;
+        }
+
+        BallKernels::Circles circles = { centerX.data(), centerY.data(), radius.data(), count };
+
+        // cate raze incap in bugetul de lucru, ca fiecare caz sa dureze cam la fel
+        int rayCount = std::max(64, std::min(MAX_RAY_COUNT, MAX_RAY_WORK / count));
+        vector<BallKernels::Ray> rays(rayCount);
+        for (int index = 0; index < rayCount; index++)
+        {
+            float angle = unit(random) * 6.2831853f;
+            rays[index].Origin = vec2(unit(random) * side, unit(random) * side);
+            rays[index].Direction = vec2(cos(angle), sin(angle));
+            rays[index].MaxDistance = 1e30f;
+            rays[index].IgnoredIndex = (int)(unit(random) * count);
+        }
+
+        vector<BallKernels::RayHit> reference(rayCount), hits(rayCount);
+        BallKernels::CastRays(rays.data(), rayCount, circles, reference.data(), BallKernels::InstructionSet::Scalar);
+
+        int best = (int)BallKernels::GetBestInstructionSet();
+        for (int instructionSet = 0; instructionSet <= best; instructionSet++)
+        {
+            BallKernels::InstructionSet set = (BallKernels::InstructionSet)instructionSet;
+
+            auto start = chrono::steady_clock::now();
+            for (int index = 0; index < rayCount; index++)
+                hits[index] = BallKernels::CastRay(rays[index], circles, set);
+            double single = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            bool identical = SameHits(hits, reference);
+
+            start = chrono::steady_clock::now();
+            BallKernels::CastRays(rays.data(), rayCount, circles, hits.data(), set);
+            double batch = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            identical = identical && SameHits(hits, reference);
+
+            printf("  %6d cercuri %-7s CastRay %10.1f ns pe raza, CastRays %10.1f ns pe raza, %s\n",
+                   count, INSTRUCTION_SET_NAMES[instructionSet], single / rayCount * 1e9, batch / rayCount * 1e9, identical ? "identic" : "DIFERIT");
+
+            if (!identical)
+                printf("ERROR::RAY_BENCH::RESULTS_DIFFER_FROM_SCALAR %s\n", INSTRUCTION_SET_NAMES[instructionSet]);
+        }
+    }
+}
+
+void RunRayBench()
+{
+    printf("Raze: CastRay si CastRays pe fiecare set de instructiuni\n");
+
+    mt19937 random(1);
+    for (int count : CIRCLE_COUNTS)
+        RunCircleCount(count, random);
+}
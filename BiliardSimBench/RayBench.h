@@ -0,0 +1,7 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+// BallKernels::CastRay apelat pentru fiecare raza fata de CastRays pe tot lotul, pe fiecare set de instructiuni
+// disponibil, pe 16, 1000 si 100000 de cercuri. Verifica si ca rezultatele sunt identice cu cele de la Scalar.
+void RunRayBench();
@@ -0,0 +1,114 @@
+#include "SolverBench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "BallWorld.h"
+#include "Hole.h"
+#include "Physics.h"
+#include "Table.h"
+
+using namespace std;
+using namespace glm;
+
+namespace
+{
+    const float FRAME_TIME       = 1.0f / 120.0f;
+    const int   TABLE_SEEDS      = 4;
+    const int   SHOTS_PER_TABLE  = 3;
+    const int   BLOCK_SIDE       = 12;
+    const float BLOCK_RADIUS     = 5.0f;
+    const float BLOCK_HIT_SPEED  = 3000.0f;
+    const int   BLOCK_FRAMES     = 120;
+
+    const char* SOLVER_NAMES[] = { "TimeStepped", "EventDriven", "SequentialImpulse" };
+
+    struct FrameTimes
+    {
+        int    Frames;
+        double Seconds;
+        double Worst;
+    };
+
+    template <typename Update>
+    void TimeFrame(FrameTimes& times, Update update)
+    {
+        auto start = chrono::steady_clock::now();
+        update();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        times.Frames++;
+        times.Seconds += seconds;
+        times.Worst = std::max(times.Worst, seconds);
+    }
+
+    FrameTimes RunTables(Physics::Solver solver)
+    {
+        FrameTimes times = { 0, 0.0, 0.0 };
+
+        for (unsigned int seed = 1; seed <= TABLE_SEEDS; seed++)
+        {
+            Table table(seed);
+            table.GetPhysics().SetDeterministic(true);
+            table.GetPhysics().SetSolver(solver);
+
+            mt19937 random(seed);
+            uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+            for (int shot = 0; shot < SHOTS_PER_TABLE && table.GetGameState() == Table::GameState::Playing; shot++)
+            {
+                float angle = unit(random) * 6.2831853f;
+                vec2 velocity = shot == 0 ? vec2(1200.0f, (unit(random) - 0.5f) * 20.0f) : vec2(cos(angle), sin(angle)) * (150.0f + unit(random) * 600.0f);
+
+                table.ApplyShot(velocity);
+                while (table.GetGameState() == Table::GameState::Waiting)
+                    TimeFrame(times, [&]() { table.Update(FRAME_TIME); });
+            }
+        }
+
+        return times;
+    }
+
+    FrameTimes RunBlock(Physics::Solver solver)
+    {
+        FrameTimes times = { 0, 0.0, 0.0 };
+
+        BallWorld world;
+        for (int row = 0; row < BLOCK_SIDE; row++)
+            for (int column = 0; column < BLOCK_SIDE; column++)
+                world.Add(vec2(400.0f + column * 2.0f * BLOCK_RADIUS, 200.0f + row * 2.0f * BLOCK_RADIUS), vec3(1.0f), true, Ball::BallType::Normal, BLOCK_RADIUS);
+
+        int handle = world.Add(vec2(100.0f, 255.0f), vec3(1.0f), true, Ball::BallType::Normal, BLOCK_RADIUS);
+        world.SetVelocity(world.GetSlot(handle), vec2(BLOCK_HIT_SPEED, 0.0f));
+
+        Physics physics;
+        physics.SetSolver(solver);
+        vector<Hole*> holes;
+
+        for (int frame = 0; frame < BLOCK_FRAMES && world.GetAwakeCount() > 0; frame++)
+            TimeFrame(times, [&]() { physics.Update(FRAME_TIME, world, holes); });
+
+        return times;
+    }
+
+    void Print(const char* name, const FrameTimes& times)
+    {
+        printf("  %-17s %6d cadre, %9.2f us pe cadru, cel mai lent %9.1f us\n", name, times.Frames, times.Seconds / times.Frames * 1e6, times.Worst * 1e6);
+    }
+}
+
+void RunSolverBench()
+{
+    printf("Solvere: mese de joc, %d mese cu cate %d lovituri, cadre de 1/120 s\n", TABLE_SEEDS, SHOTS_PER_TABLE);
+    for (int solver = 0; solver < 3; solver++)
+        Print(SOLVER_NAMES[solver], RunTables((Physics::Solver)solver));
+
+    printf("Solvere: bloc de %d bile lipite lovit cu %.0f, cel mult %d cadre\n", BLOCK_SIDE * BLOCK_SIDE, BLOCK_HIT_SPEED, BLOCK_FRAMES);
+    for (int solver = 0; solver < 3; solver++)
+        Print(SOLVER_NAMES[solver], RunBlock((Physics::Solver)solver));
+}
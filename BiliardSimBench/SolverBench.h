@@ -0,0 +1,7 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+// Costul unui cadru de 1/120 s cu fiecare solver: pe mese de joc (spargere si inca doua lovituri, ca in Game)
+// si pe un bloc de 144 de bile lipite lovit de o bila foarte rapida, unde EventSolver are cele mai multe evenimente.
+void RunSolverBench();
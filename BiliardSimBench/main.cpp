@@ -0,0 +1,61 @@
+#include <cstring>
+#include <iostream>
+
+#include "BroadphaseBench.h"
+#include "ContactBench.h"
+#include "EvaluatorBench.h"
+#include "PrecisionBench.h"
+#include "QuadtreeBench.h"
+#include "RayBench.h"
+#include "SolverBench.h"
+
+using namespace std;
+
+namespace
+{
+    struct Benchmark
+    {
+        const char* Name;
+        void        (*Run)();
+    };
+
+    const Benchmark BENCHMARKS[] =
+    {
+        { "broadphase", RunBroadphaseBench },
+        { "contacts",   RunContactBench },
+        { "evaluator",  RunEvaluatorBench },
+        { "precision",  RunPrecisionBench },
+        { "quadtree",   RunQuadtreeBench },
+        { "rays",       RunRayBench },
+        { "solvers",    RunSolverBench }
+    };
+}
+
+// Masuratori pentru BiliardSim, fara fereastra. Fara argumente le ruleaza pe toate; altfel doar pe cele numite.
+int main(int argc, char const* argv[])
+{
+    for (int arg = 1; arg < argc; arg++)
+    {
+        bool known = false;
+        for (auto& benchmark : BENCHMARKS)
+            known = known || strcmp(argv[arg], benchmark.Name) == 0;
+
+        if (!known)
+        {
+            cout << "ERROR::BENCH::UNKNOWN_BENCHMARK " << argv[arg] << endl;
+            return 1;
+        }
+    }
+
+    for (auto& benchmark : BENCHMARKS)
+    {
+        bool selected = argc <= 1;
+        for (int arg = 1; arg < argc; arg++)
+            selected = selected || strcmp(argv[arg], benchmark.Name) == 0;
+
+        if (selected)
+            benchmark.Run();
+    }
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "EvaluatorTests.h"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Physics.h"
+#include "QuietConsole.h"
+#include "ShotEvaluator.h"
+#include "Table.h"
+
+using namespace std;
+using namespace glm;
+
+namespace
+{
+    const unsigned int SEED               = 1;
+    const int          SHOT_COUNT         = 16;
+    const int          MAX_STEPS_PER_SHOT = 100000;
+    const float        MIN_POWER          = 80.0f;
+    const float        MAX_POWER          = 1000.0f;
+
+    bool SameOutcome(const ShotEvaluator::ShotOutcome& a, const ShotEvaluator::ShotOutcome& b)
+    {
+        return a.PocketedBalls == b.PocketedBalls && a.WhiteBallPosition == b.WhiteBallPosition && a.Fouls == b.Fouls && a.Time == b.Time;
+    }
+}
+
+bool RunEvaluatorTests()
+{
+    vector<string> failed;
+
+    {
+        QuietConsole quiet;
+
+        Table table(SEED);
+        table.GetPhysics().SetDeterministic(true);
+
+        mt19937 random(SEED);
+        uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        vector<vec2> shots;
+        for (int shot = 0; shot < SHOT_COUNT; shot++)
+        {
+            float angle = unit(random) * 6.2831853f;
+            shots.push_back(vec2(cos(angle), sin(angle)) * (MIN_POWER + unit(random) * (MAX_POWER - MIN_POWER)));
+        }
+
+        // aceleasi lovituri, pe mai multi workeri si apoi pe unul singur, in ordine inversa
+        ShotEvaluator pooled(4);
+        vector<ShotEvaluator::ShotOutcome> outcomes;
+        pooled.Evaluate(table, shots, outcomes);
+
+        ShotEvaluator single(1);
+        vector<vec2> reversedShots(shots.rbegin(), shots.rend());
+        vector<ShotEvaluator::ShotOutcome> reversedOutcomes;
+        single.Evaluate(table, reversedShots, reversedOutcomes);
+
+        for (int shot = 0; shot < SHOT_COUNT; shot++)
+        {
+            const ShotEvaluator::ShotOutcome& outcome = outcomes[shot];
+
+            if (!SameOutcome(outcome, reversedOutcomes[SHOT_COUNT - 1 - shot]))
+                failed.push_back("lovitura " + to_string(shot) + " depinde de worker sau de ordine");
+
+            Table played(SEED);
+            played.GetPhysics().SetDeterministic(true);
+            played.ApplyShot(shots[shot]);
+            for (int step = 0; step < MAX_STEPS_PER_SHOT && played.GetGameState() == Table::GameState::Waiting; step++)
+                played.Update(Physics::DETERMINISTIC_STEP);
+
+            // masa pune bila alba inapoi dupa fault si se opreste cand se termina meciul, asa ca acolo nu se poate compara
+            if ((outcome.Fouls & ShotEvaluator::Fouls::ScratchFoul) || played.GetGameState() == Table::GameState::Finished)
+                continue;
+
+            int pocketed = table.GetWorld().GetCount() - played.GetWorld().GetCount();
+            vec2 whitePosition = played.GetWorld().GetBall(played.GetWhiteBall()).GetPosition();
+
+            if ((int)outcome.PocketedBalls.size() != pocketed || outcome.WhiteBallPosition != whitePosition)
+                failed.push_back("lovitura " + to_string(shot) + " iese altfel decat pe masa");
+        }
+    }
+
+    for (const string& failure : failed)
+        cout << "FAILED::SHOT_EVALUATOR " << failure << endl;
+
+    cout << "ShotEvaluator: " << SHOT_COUNT << " lovituri, " << failed.size() << " esecuri" << endl;
+
+    return failed.empty();
+}
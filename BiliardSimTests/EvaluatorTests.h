@@ -0,0 +1,7 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+// ShotEvaluator pe o masa determinista: fiecare lovitura iese la fel oricare ar fi workerul si ordinea in care
+// sunt evaluate, si la fel ca pe masa (pozitia bilei albe si bilele bagate in gauri).
+bool RunEvaluatorTests();
@@ -0,0 +1,54 @@
+#include "FixedTests.h"
+
+#include <climits>
+#include <iostream>
+
+#include "Fixed.h"
+
+using namespace std;
+
+namespace
+{
+    struct DivisionCase
+    {
+        const char* Name;
+        long long   Dividend;
+        long long   Divisor;
+        long long   Expected;
+    };
+
+    const long long ONE = 1LL << Fixed::FRACTION_BITS;
+
+    const DivisionCase DIVISIONS[] =
+    {
+        { "7 / 2",                          7 * ONE,        2 * ONE,       3 * ONE + ONE / 2 },
+        { "-1 / 3",                         -ONE,           3 * ONE,       -1431655765 },
+        { "cel mai mic / 1",                LLONG_MIN,      ONE,           LLONG_MIN },
+        { "aproape 1, impartitor mare",     LLONG_MAX - 1,  LLONG_MAX,     ONE - 1 },
+        { "impartitor mare negativ",        ONE,            LLONG_MIN,     -2 },
+        { "2^31 - 1 / 0.5",                 LLONG_MAX,      ONE / 2,       LLONG_MAX },
+        { "cel mai mic / -1",               LLONG_MIN,      -ONE,          LLONG_MAX },
+        { "1 / cel mai mic pas",            ONE,            1,             LLONG_MAX },
+        { "-1 / cel mai mic pas",           -ONE,           1,             LLONG_MIN },
+        { "impartire la zero",              -ONE,           0,             LLONG_MIN }
+    };
+}
+
+bool RunFixedTests()
+{
+    int failures = 0;
+
+    for (const DivisionCase& division : DIVISIONS)
+    {
+        long long result = (Fixed::FromRaw(division.Dividend) / Fixed::FromRaw(division.Divisor)).GetRaw();
+        if (result == division.Expected)
+            continue;
+
+        cout << "FAILED::FIXED_DIVISION " << division.Name << ": " << result << " in loc de " << division.Expected << endl;
+        failures++;
+    }
+
+    cout << "Fixed: " << (int)(sizeof(DIVISIONS) / sizeof(DIVISIONS[0])) << " impartiri, " << failures << " esecuri" << endl;
+
+    return failures == 0;
+}
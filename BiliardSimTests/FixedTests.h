@@ -0,0 +1,7 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+// Impartirea Fixed: catul exact trunchiat spre zero, si cand impartitorul foloseste toti cei 64 de biti,
+// iar catul care nu incape in 32.32 satureaza in loc sa dea un numar oarecare.
+bool RunFixedTests();
@@ -0,0 +1,108 @@
+#include "KernelTests.h"
+
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <glm/glm.hpp>
+
+#include "BallKernels.h"
+#include "BallWorld.h"
+
+using namespace std;
+using namespace glm;
+
+namespace
+{
+    const int   WORLD_SIZES[]       = { 1, 5, 16, 37, 100 };
+    const float STEPS[]             = { 1.0f / 120.0f, 1.0f / 30.0f };
+    const int   STEP_COUNT          = 300;
+    const float MAX_SPEED           = 1500.0f;
+    const float ASLEEP_PROBABILITY  = 0.2f;
+
+    const char* INSTRUCTION_SET_NAMES[] = { "Scalar", "SSE", "AVX2", "AVX512" };
+
+    // Viteze de toate felurile: rapide, aproape de oprire (unde testul de oprire decide) si zero; unele bile dorm.
+    BallWorld CreateWorld(int count, unsigned int seed)
+    {
+        mt19937 random(seed);
+        uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+        BallWorld world;
+        for (int index = 0; index < count; index++)
+        {
+            int slot = world.Add(vec2(unit(random) * 1000.0f, unit(random) * 500.0f), vec3(1.0f), true);
+
+            float angle = unit(random) * 6.2831853f;
+            float speed = 0.0f;
+            switch (index % 3)
+            {
+            case 0:
+                speed = unit(random) * MAX_SPEED;
+                break;
+            case 1:
+                speed = unit(random) * 2.0f;
+                break;
+            }
+
+            // pentru viteza zero vectorul poate avea componente -0, pe care BallWorld nu le pastreaza la bilele adormite
+            world.SetVelocity(slot, vec2(cos(angle), sin(angle)) * speed);
+
+            if (unit(random) < ASLEEP_PROBABILITY)
+                world.Sleep(slot);
+        }
+
+        return world;
+    }
+
+    bool SameBits(const float* first, const float* second, int count)
+    {
+        return memcmp(first, second, count * sizeof(float)) == 0;
+    }
+
+    bool SameState(BallWorld& first, BallWorld& second)
+    {
+        int count = first.GetCount();
+
+        return SameBits(first.GetPositionsX(), second.GetPositionsX(), count) &&
+               SameBits(first.GetPositionsY(), second.GetPositionsY(), count) &&
+               SameBits(first.GetVelocitiesX(), second.GetVelocitiesX(), count) &&
+               SameBits(first.GetVelocitiesY(), second.GetVelocitiesY(), count) &&
+               memcmp(first.GetFlags(), second.GetFlags(), count) == 0;
+    }
+}
+
+bool RunKernelTests()
+{
+    int best = (int)BallKernels::GetBestInstructionSet();
+    int failures = 0;
+
+    for (int instructionSet = 1; instructionSet <= best; instructionSet++)
+    {
+        for (int size : WORLD_SIZES)
+        {
+            for (float deltaTime : STEPS)
+            {
+                BallWorld reference = CreateWorld(size, (unsigned int)size);
+                BallWorld world = reference;
+
+                for (int step = 0; step < STEP_COUNT; step++)
+                {
+                    BallKernels::UpdateFriction(deltaTime, reference, BallKernels::InstructionSet::Scalar);
+                    BallKernels::UpdateFriction(deltaTime, world, (BallKernels::InstructionSet)instructionSet);
+
+                    if (SameState(reference, world))
+                        continue;
+
+                    cout << "FAILED::FRICTION_KERNEL " << INSTRUCTION_SET_NAMES[instructionSet] << " cu " << size << " bile, pas "
+                         << deltaTime << ": diferit de Scalar la pasul " << step << endl;
+                    failures++;
+                    break;
+                }
+            }
+        }
+    }
+
+    cout << "BallKernels: " << best << " seturi de instructiuni fata de Scalar, " << failures << " esecuri" << endl;
+
+    return failures == 0;
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+// Variantele SSE, AVX2 si AVX-512 din BallKernels::UpdateFriction trebuie sa dea exact aceleasi pozitii, viteze
+// si flag-uri ca varianta Scalar, bit cu bit, pe lumi de mai multe marimi (si cu loturi incomplete la sfarsit).
+bool RunKernelTests();
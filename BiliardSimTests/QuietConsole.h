@@ -0,0 +1,28 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+#include <iostream>
+#include <streambuf>
+
+// Cat timp exista, tot ce scrie masa in cout (al cui este randul, mesajele ERROR asteptate) este aruncat,
+// ca in iesirea testelor sa ramana doar rezultatele si esecurile.
+class QuietConsole
+{
+public:
+    QuietConsole() : m_previous(std::cout.rdbuf(&m_discard)) {}
+    ~QuietConsole() { std::cout.rdbuf(m_previous); }
+
+    QuietConsole(const QuietConsole&) = delete;
+    QuietConsole& operator=(const QuietConsole&) = delete;
+
+private:
+    class DiscardBuffer : public std::streambuf
+    {
+    protected:
+        int overflow(int c) override { return traits_type::not_eof(c); }
+    };
+
+    DiscardBuffer   m_discard;
+    std::streambuf* m_previous;
+};
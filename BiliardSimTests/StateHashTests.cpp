@@ -0,0 +1,104 @@
+#include "StateHashTests.h"
+
+#include <cstdio>
+#include <iostream>
+#include <glm/glm.hpp>
+
+#include "BallKernels.h"
+#include "Physics.h"
+#include "QuietConsole.h"
+#include "Table.h"
+#include "ThreadPool.h"
+
+using namespace std;
+using namespace glm;
+
+namespace
+{
+    const int MAX_SHOTS          = 4;
+    const int MAX_STEPS_PER_SHOT = 100000;
+    const int POOL_THREADS       = 4;
+
+    // Loviturile sunt aplicate pe rand pe masa creata cu Seed, fiecare simulata pana la oprirea bilelor,
+    // ca in ReplayPlayer. ExpectedHash este Table::GetStateHash dupa ultima lovitura.
+    struct ShotCase
+    {
+        const char*        Name;
+        unsigned int       Seed;
+        Physics::Solver    Solver;
+        int                ShotCount;
+        vec2               Shots[MAX_SHOTS];
+        unsigned long long ExpectedHash;
+    };
+
+    const ShotCase CORPUS[] =
+    {
+        { "spargere dreapta",       1, Physics::Solver::TimeStepped,       1, { vec2(1200.0f, 0.0f) },                                                   0x9cbcab0cd760b662ull },
+        { "spargere din unghi",     2, Physics::Solver::TimeStepped,       1, { vec2(1000.0f, 35.0f) },                                                  0x1a4575d0390b6079ull },
+        { "lovituri usoare",        3, Physics::Solver::TimeStepped,       3, { vec2(300.0f, 10.0f), vec2(-150.0f, 120.0f), vec2(90.0f, -260.0f) },       0xce963af53c1d09d7ull },
+        { "manta",                  4, Physics::Solver::TimeStepped,       2, { vec2(900.0f, 0.0f), vec2(0.0f, 700.0f) },                                0x3c597902e294db32ull },
+        { "spargere dreapta",       1, Physics::Solver::EventDriven,       1, { vec2(1200.0f, 0.0f) },                                                   0xabe0bbcebe5be174ull },
+        { "lovituri usoare",        3, Physics::Solver::EventDriven,       3, { vec2(300.0f, 10.0f), vec2(-150.0f, 120.0f), vec2(90.0f, -260.0f) },       0xc6ec99051ce6f49eull },
+        { "meci scurt",             5, Physics::Solver::EventDriven,       4, { vec2(1100.0f, -20.0f), vec2(400.0f, 400.0f), vec2(-600.0f, 50.0f), vec2(200.0f, -500.0f) }, 0x47639ed5ab372b33ull },
+        { "spargere dreapta",       1, Physics::Solver::SequentialImpulse, 1, { vec2(1200.0f, 0.0f) },                                                   0x3112de36b5c223a2ull },
+        { "spargere din unghi",     2, Physics::Solver::SequentialImpulse, 1, { vec2(1000.0f, 35.0f) },                                                  0xaf1a0d521a722f39ull },
+        { "meci scurt",             5, Physics::Solver::SequentialImpulse, 4, { vec2(1100.0f, -20.0f), vec2(400.0f, 400.0f), vec2(-600.0f, 50.0f), vec2(200.0f, -500.0f) }, 0x9ecfbf5fee040237ull }
+    };
+
+    const char* SOLVER_NAMES[]          = { "TimeStepped", "EventDriven", "SequentialImpulse" };
+    const char* INSTRUCTION_SET_NAMES[] = { "Scalar", "SSE", "AVX2", "AVX512" };
+
+    unsigned long long Simulate(const ShotCase& shotCase, BallKernels::InstructionSet instructionSet, ThreadPool* threadPool)
+    {
+        QuietConsole quiet;
+
+        Table table(shotCase.Seed);
+        table.GetPhysics().SetDeterministic(true);
+        table.GetPhysics().SetSolver(shotCase.Solver);
+        table.GetPhysics().SetInstructionSet(instructionSet);
+        table.GetPhysics().SetThreadPool(threadPool);
+
+        for (int shot = 0; shot < shotCase.ShotCount; shot++)
+        {
+            if (!table.ApplyShot(shotCase.Shots[shot]))
+                break;
+
+            for (int step = 0; step < MAX_STEPS_PER_SHOT && table.GetGameState() == Table::GameState::Waiting; step++)
+                table.Update(Physics::DETERMINISTIC_STEP);
+        }
+
+        return table.GetStateHash();
+    }
+}
+
+bool RunStateHashTests()
+{
+    ThreadPool threadPool(POOL_THREADS);
+
+    int best = (int)BallKernels::GetBestInstructionSet();
+    int failures = 0;
+
+    for (auto& shotCase : CORPUS)
+    {
+        for (int instructionSet = 0; instructionSet <= best; instructionSet++)
+        {
+            for (int pooled = 0; pooled < 2; pooled++)
+            {
+                unsigned long long hash = Simulate(shotCase, (BallKernels::InstructionSet)instructionSet, pooled ? &threadPool : nullptr);
+                if (hash == shotCase.ExpectedHash)
+                    continue;
+
+                char text[32];
+                snprintf(text, sizeof(text), "0x%016llx", hash);
+
+                cout << "FAILED::STATE_HASH " << shotCase.Name << " (samanta " << shotCase.Seed << ", " << SOLVER_NAMES[(int)shotCase.Solver]
+                     << ", " << INSTRUCTION_SET_NAMES[instructionSet] << (pooled ? ", cu ThreadPool" : "") << "): " << text << endl;
+                failures++;
+            }
+        }
+    }
+
+    cout << "StateHash: " << (int)(sizeof(CORPUS) / sizeof(CORPUS[0])) << " cazuri, " << failures << " esecuri" << endl;
+
+    return failures == 0;
+}
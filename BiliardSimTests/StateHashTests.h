@@ -0,0 +1,8 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+// Un set fix de lovituri simulate in modul determinist, cu fiecare solver, fiecare set de instructiuni disponibil
+// si cu sau fara ThreadPool. StateHash-ul mesei dupa ultima lovitura trebuie sa fie mereu cel inregistrat in corpus;
+// un hash diferit inseamna ca fizica nu mai da aceleasi rezultate (dintr-o schimbare voita sau dintr-o greseala).
+bool RunStateHashTests();
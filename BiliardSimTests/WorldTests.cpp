@@ -0,0 +1,172 @@
+#include "WorldTests.h"
+
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "BallWorld.h"
+#include "Hole.h"
+#include "Physics.h"
+#include "QuietConsole.h"
+#include "Table.h"
+#include "TableState.h"
+
+using namespace std;
+using namespace glm;
+
+namespace
+{
+    const int   BALL_COUNT       = 100;
+    const int   POCKETED[]       = { 0, 5, 31, 32, 40, 99 };
+    const float SPACING          = 50.0f;
+
+    bool IsPocketed(int handle)
+    {
+        for (int pocketed : POCKETED)
+            if (pocketed == handle)
+                return true;
+
+        return false;
+    }
+
+    int TestRemovePocketed()
+    {
+        BallWorld world;
+        for (int index = 0; index < BALL_COUNT; index++)
+            world.Add(vec2(20.0f + (index % 20) * SPACING, 20.0f + (index / 20) * SPACING), vec3(1.0f), true);
+
+        for (int handle : POCKETED)
+            world.SetOnBoard(world.GetSlot(handle), false);
+
+        Physics physics;
+        vector<Hole*> holes;
+
+        // arborele trebuie sa aiba toate bilele inainte de a fi scoase
+        physics.Update(Physics::DETERMINISTIC_STEP, world, holes);
+        physics.RemovePocketed(world);
+
+        int failures = 0;
+        int expectedCount = BALL_COUNT - (int)(sizeof(POCKETED) / sizeof(POCKETED[0]));
+
+        if (world.GetCount() != expectedCount || world.GetPocketedCount() != 0)
+        {
+            cout << "FAILED::REMOVE_POCKETED " << world.GetCount() << " bile ramase, " << world.GetPocketedCount() << " bagate in gauri" << endl;
+            failures++;
+        }
+
+        int previousHandle = -1;
+        for (int slot = 0; slot < world.GetCount(); slot++)
+        {
+            int handle = world.GetHandle(slot);
+            if (handle <= previousHandle || IsPocketed(handle) || world.GetSlot(handle) != slot)
+            {
+                cout << "FAILED::REMOVE_POCKETED slotul " << slot << " are handle-ul " << handle << endl;
+                failures++;
+            }
+            previousHandle = handle;
+        }
+
+        for (int handle : POCKETED)
+        {
+            if (world.GetSlot(handle) != -1)
+            {
+                cout << "FAILED::REMOVE_POCKETED handle-ul " << handle << " este inca in lume" << endl;
+                failures++;
+            }
+        }
+
+        // bila 1 trece prin locul bilei 0, scoase; arborele nu trebuie sa mai dea perechi cu ea
+        physics.SetContactRecording(true);
+        world.SetVelocity(world.GetSlot(1), vec2(-240.0f, 0.0f));
+        for (int step = 0; step < 8; step++)
+            physics.Update(Physics::DETERMINISTIC_STEP, world, holes);
+
+        for (const ShotEvents::Contact& contact : physics.GetShotEvents().Contacts)
+        {
+            if (contact.Type == ShotEvents::ContactType::Ball)
+            {
+                cout << "FAILED::REMOVE_POCKETED ciocnire a bilei " << contact.Handle << " la " << contact.Position.x << "," << contact.Position.y << " dupa ce bilele au fost scoase" << endl;
+                failures++;
+            }
+        }
+
+        return failures;
+    }
+
+    // O stare stricata intr-un singur camp.
+    struct InvalidState
+    {
+        const char* Name;
+        void        (*Corrupt)(TableState&);
+    };
+
+    const InvalidState INVALID_STATES[] =
+    {
+        { "stare de joc",          [](TableState& state) { state.GameState = 7; } },
+        { "jucator curent",        [](TableState& state) { state.CurrentPlayer = -1; } },
+        { "bila alba",             [](TableState& state) { state.WhiteBall = 99; } },
+        { "bila neagra",           [](TableState& state) { state.BlackBall = state.HandleCount; } },
+        { "numar de bile",         [](TableState& state) { state.BallCount = -3; } },
+        { "numar de handle-uri",   [](TableState& state) { state.HandleCount = state.BallCount - 1; } },
+        { "handle dublat",         [](TableState& state) { state.Balls[4].Handle = state.Balls[3].Handle; } },
+        { "tip de bila",           [](TableState& state) { state.Balls[3].Type = (Ball::BallType)9; } },
+        { "flag-uri",              [](TableState& state) { state.Balls[3].Flags |= 0x80; } },
+        { "bila scoasa treaza",    [](TableState& state) { state.Balls[3].Flags &= ~(BallWorld::OnBoardFlag | BallWorld::AsleepFlag); } },
+        { "pozitie",               [](TableState& state) { state.Balls[3].Position.x = numeric_limits<float>::quiet_NaN(); } },
+        { "raza",                  [](TableState& state) { state.Balls[3].Radius = 0.0f; } },
+        { "contact in cache",      [](TableState& state) { state.CachedContactCount = 1; state.CachedContacts[0] = { 0, 40, 1.0f }; } },
+        { "acumulator",            [](TableState& state) { state.PhysicsAccumulator = -1.0f; } }
+    };
+
+    // O stare invalida este refuzata fara sa schimbe masa; una valida este pusa inapoi exact, cu bilele treze numarate din flag-uri.
+    // Masa scrie in consola mesajele ERROR asteptate, asa ca esecurile sunt adunate si afisate dupa.
+    int TestRestoreState()
+    {
+        vector<string> failed;
+
+        {
+            QuietConsole quiet;
+
+            Table table(1);
+            table.GetPhysics().SetDeterministic(true);
+            table.ApplyShot(vec2(1200.0f, 0.0f));
+            for (int frame = 0; frame < 30; frame++)
+                table.Update(Physics::DETERMINISTIC_STEP);
+
+            TableState saved;
+            table.SaveState(saved);
+            unsigned long long hash = table.GetStateHash();
+            int awakeCount = table.GetWorld().GetAwakeCount();
+
+            for (const InvalidState& invalid : INVALID_STATES)
+            {
+                TableState state = saved;
+                invalid.Corrupt(state);
+
+                if (table.RestoreState(state) || table.GetStateHash() != hash)
+                    failed.push_back(string("stare acceptata sau masa schimbata: ") + invalid.Name);
+            }
+
+            Table restored(2);
+            restored.GetPhysics().SetDeterministic(true);
+            if (!restored.RestoreState(saved) || restored.GetStateHash() != hash || restored.GetWorld().GetAwakeCount() != awakeCount)
+                failed.push_back("starea valida nu a fost pusa inapoi exact");
+        }
+
+        for (const string& failure : failed)
+            cout << "FAILED::RESTORE_STATE " << failure << endl;
+
+        return (int)failed.size();
+    }
+}
+
+bool RunWorldTests()
+{
+    int failures = TestRemovePocketed() + TestRestoreState();
+
+    cout << "BallWorld: " << failures << " esecuri" << endl;
+
+    return failures == 0;
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "FloatingPoint.h"
+
+// BallWorld si Physics pe lumi mai mari decat masca de handle-uri: bilele bagate in gauri sunt scoase din lume
+// si din arbore oricare ar fi handle-ul lor, iar bilele ramase isi pastreaza ordinea.
+// Table::RestoreState refuza starile invalide fara sa schimbe masa si le pune inapoi exact pe cele valide.
+bool RunWorldTests();
@@ -0,0 +1,25 @@
+#include <iostream>
+
+#include "EvaluatorTests.h"
+#include "FixedTests.h"
+#include "KernelTests.h"
+#include "StateHashTests.h"
+#include "WorldTests.h"
+
+using namespace std;
+
+// Testele pentru BiliardSim, fara fereastra. Intoarce 0 doar daca toate au trecut.
+int main()
+{
+    bool passed = true;
+
+    passed = RunFixedTests() && passed;
+    passed = RunKernelTests() && passed;
+    passed = RunStateHashTests() && passed;
+    passed = RunWorldTests() && passed;
+    passed = RunEvaluatorTests() && passed;
+
+    cout << (passed ? "Toate testele au trecut." : "Unele teste au esuat.") << endl;
+
+    return passed ? 0 : 1;
+}